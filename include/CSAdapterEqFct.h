@@ -16,6 +16,7 @@ namespace ChimeraTK {
   class DoocsProcessArray;
   class StatusHandler;
   class DoocsUpdater;
+  class PropertyBase;
   struct PropertyDescription;
 
   class CSAdapterEqFct : public EqFct, boost::noncopyable {
@@ -30,6 +31,9 @@ namespace ChimeraTK {
 
     boost::shared_ptr<StatusHandler> _statusHandler;
 
+    // properties with lazy updates, which need to be filled before being persisted (see PropertyBase::setLazy())
+    std::vector<PropertyBase*> _lazyProperties;
+
    public:
     CSAdapterEqFct(int code, const EqFctParameters& p);
     ~CSAdapterEqFct() override;
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <ChimeraTK/NDRegisterAccessorDecorator.h>
+#include <ChimeraTK/SupportedUserTypes.h>
+
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+namespace ChimeraTK {
+
+  /**
+   * Decorator converting between numeric types (including ChimeraTK::Boolean) with a plain static_cast, i.e. the same
+   * result as the TypeChangingDecorator with DecoratorType::C_style_conversion. The conversion of each channel is done
+   * in one tight loop over the contiguous buffer, which the compiler vectorises for the arithmetic type pairs.
+   */
+  template<typename UserType, typename TargetType>
+  class ConvertingDecorator : public NDRegisterAccessorDecorator<UserType, TargetType> {
+   public:
+    using NDRegisterAccessorDecorator<UserType, TargetType>::NDRegisterAccessorDecorator;
+
+    void doPreRead(TransferType type) override { _target->preRead(type); }
+    void doPostRead(TransferType type, bool hasNewData) override;
+    void doPreWrite(TransferType type, VersionNumber versionNumber) override;
+    void doPostWrite(TransferType type, VersionNumber versionNumber) override {
+      _target->postWrite(type, versionNumber);
+    }
+
+   protected:
+    using NDRegisterAccessorDecorator<UserType, TargetType>::_target;
+  };
+
+  /********************************************************************************************************************/
+
+  namespace detail {
+    template<typename T>
+    constexpr bool isConvertibleNumeric = std::is_arithmetic_v<T> || std::is_same_v<T, Boolean>;
+
+    template<typename To, typename From>
+    void convertBuffer(const std::vector<From>& from, std::vector<To>& to) {
+      assert(from.size() == to.size());
+      const From* __restrict in = from.data();
+      To* __restrict out = to.data();
+      const size_t n = from.size();
+      for(size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<To>(in[i]);
+      }
+    }
+  } // namespace detail
+
+  /********************************************************************************************************************/
+
+  /**
+   * Return a ConvertingDecorator<UserType, ...> around the given accessor, if both its value type and UserType are
+   * numeric and different. Otherwise nullptr is returned, and the generic TypeChangingDecorator has to be used.
+   */
+  template<typename UserType>
+  boost::shared_ptr<NDRegisterAccessor<UserType>> getConvertingDecorator(const TransferElement::SharedPtr& target) {
+    boost::shared_ptr<NDRegisterAccessor<UserType>> decorator;
+    if constexpr(detail::isConvertibleNumeric<UserType>) {
+      callForType(target->getValueType(), [&](auto t) {
+        using TargetType = decltype(t);
+        if constexpr(detail::isConvertibleNumeric<TargetType> && !std::is_same_v<TargetType, UserType>) {
+          auto typedTarget = boost::dynamic_pointer_cast<NDRegisterAccessor<TargetType>>(target);
+          assert(typedTarget);
+          decorator = boost::make_shared<ConvertingDecorator<UserType, TargetType>>(typedTarget);
+        }
+      });
+    }
+    return decorator;
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType, typename TargetType>
+  void ConvertingDecorator<UserType, TargetType>::doPostRead(TransferType type, bool hasNewData) {
+    _target->postRead(type, hasNewData);
+    if(!hasNewData) {
+      return;
+    }
+    for(size_t channel = 0; channel < this->buffer_2D.size(); ++channel) {
+      detail::convertBuffer(_target->accessChannel(channel), this->buffer_2D[channel]);
+    }
+    this->_versionNumber = _target->getVersionNumber();
+    this->_dataValidity = _target->dataValidity();
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType, typename TargetType>
+  void ConvertingDecorator<UserType, TargetType>::doPreWrite(TransferType type, VersionNumber versionNumber) {
+    for(size_t channel = 0; channel < this->buffer_2D.size(); ++channel) {
+      detail::convertBuffer(this->buffer_2D[channel], _target->accessChannel(channel));
+    }
+    _target->setDataValidity(this->_dataValidity);
+    _target->preWrite(type, versionNumber);
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
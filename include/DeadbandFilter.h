@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <ChimeraTK/TransferElement.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+namespace ChimeraTK {
+
+  /**
+   * Decides whether an update of a scalar (or of a small tuple of scalars like D_ifff) is significant enough to be
+   * published. An update is inside the deadband if every component differs from the last published value by at most
+   * max(absolute, relative * |last published value|). Changes of the data validity and the first update are always
+   * published. With both deadbands at zero (the default) the filter is inactive and every update is published.
+   */
+  class DeadbandFilter {
+   public:
+    DeadbandFilter() = default;
+    DeadbandFilter(double absolute, double relative) : _absolute(absolute), _relative(relative) {}
+
+    /// Returns whether a deadband is configured
+    [[nodiscard]] bool isActive() const { return _absolute > 0. || _relative > 0.; }
+
+    /// Returns true if the given values are inside the deadband around the last published values. Otherwise the
+    /// values are remembered as the last published values and false is returned.
+    bool isInside(std::initializer_list<double> values, DataValidity validity) {
+      if(!isActive()) {
+        return false;
+      }
+      if(_validity == validity && _published.size() == values.size() &&
+          std::equal(values.begin(), values.end(), _published.begin(),
+              [&](double value, double published) { return isInside(value, published); })) {
+        return true;
+      }
+      _published.assign(values);
+      _validity = validity;
+      return false;
+    }
+
+   protected:
+    [[nodiscard]] bool isInside(double value, double published) const {
+      return std::abs(value - published) <= std::max(_absolute, _relative * std::abs(published));
+    }
+
+    double _absolute{0.};
+    double _relative{0.};
+    std::vector<double> _published;
+    std::optional<DataValidity> _validity;
+  };
+
+} // namespace ChimeraTK
@@ -34,6 +34,7 @@ namespace ChimeraTK {
 
    protected:
     void updateDoocsBuffer(const TransferElementID& elementId) override;
+    void writeHistoryEntry(const HistoryDecimator::Sample& sample) override;
     void sendToApplication(bool getLock);
     void registerIfffSources();
     void checkSourceConsistency();
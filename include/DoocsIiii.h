@@ -32,6 +32,7 @@ namespace ChimeraTK {
 
    protected:
     void updateDoocsBuffer(const TransferElementID& elementId) override;
+    void writeHistoryEntry(const HistoryDecimator::Sample& sample) override;
     void sendToApplication(bool getLock);
     void registerIiiiSources();
     void checkSourceConsistency();
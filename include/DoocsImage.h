@@ -43,10 +43,21 @@ namespace ChimeraTK {
     IMH imh{};
     IMH* getIMH() { return &imh; }
 
+    /// Fill the DOOCS buffer first if a lazy update is pending (see PropertyBase::setLazy()). DOOCS calls it for RPC
+    /// reads with the location lock held.
+    void get(EqAdr* eqAdr, doocs::EqData* data1, doocs::EqData* data2, EqFct* eqFct) override {
+      materialiseLazyUpdate();
+      D_imagec::get(eqAdr, data1, data2, eqFct);
+    }
+
    protected:
     void updateDoocsBuffer(const TransferElementID& transferElementId) override;
+    void fillDoocsBuffer() override;
+    bool supportsLazyUpdate() override { return true; }
 
     OneDRegisterAccessor<uint8_t> _processArray;
+    // macro pulse number of the last update, used as event number in the image header
+    int64_t _eventNumber{0};
   };
 
 } // namespace ChimeraTK
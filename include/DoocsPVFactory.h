@@ -36,6 +36,9 @@ namespace ChimeraTK {
                    // constructor of the doocs properties.
     DoocsUpdater& _updater;
 
+    // create the DOOCS property matching the type of the description
+    boost::shared_ptr<D_fct> createByType(std::shared_ptr<PropertyDescription> const& propertyDescription);
+
     // create the DOOCS property. Note: DOOCS_T is only used for scalar
     // properties, not for arrays!
     template<class T, class DOOCS_T>
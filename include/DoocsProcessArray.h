@@ -31,6 +31,15 @@ namespace ChimeraTK {
      */
     void set(EqAdr* eqAdr, doocs::EqData* data1, doocs::EqData* data2, EqFct* eqFct) override;
 
+    /**
+     * Override the Doocs get method which is called for RPC reads, to fill the DOOCS buffer first if a lazy update is
+     * pending (see PropertyBase::setLazy()). DOOCS calls it with the location lock held.
+     */
+    void get(EqAdr* eqAdr, doocs::EqData* data1, doocs::EqData* data2, EqFct* eqFct) override {
+      materialiseLazyUpdate();
+      DOOCS_T::get(eqAdr, data1, data2, eqFct);
+    }
+
     /**
      * Override the Doocs auto_init() method, which is called after initialising
      * the value of the property from the config file.
@@ -42,7 +51,15 @@ namespace ChimeraTK {
     bool modified{false};
 
    protected:
-    void updateDoocsBuffer(const TransferElementID& transferElementId) override;
+    void updateDoocsBuffer(const TransferElementID& transferElementId) final;
+
+    // called by the DoocsUpdater instead of the virtual updateDoocsBuffer(), see PropertyBase::_updateThunk
+    static void updateDoocsBufferDirect(PropertyBase* property, const TransferElementID& transferElementId) {
+      static_cast<DoocsProcessArray*>(property)->DoocsProcessArray::updateDoocsBuffer(transferElementId);
+    }
+    void fillDoocsBuffer() override;
+    bool supportsLazyUpdate() override { return !_processArray.isWriteable(); }
+    bool supportsSuppressUnchanged() override { return true; }
 
     OneDRegisterAccessor<DOOCS_PRIMITIVE_T> _processArray;
 
@@ -72,6 +89,7 @@ namespace ChimeraTK {
         << ". Try selecting a different DOOCS type in the mappng XML file, e.g. a D_spectrum!";
       throw ChimeraTK::logic_error(s.str());
     }
+    _updateThunk = &DoocsProcessArray::updateDoocsBufferDirect;
     setupOutputVar(_processArray);
   }
 
@@ -121,19 +139,9 @@ namespace ChimeraTK {
 
     // Note: we already own the location lock by specification of the
     // DoocsUpdater
-    THE_DOOCS_TYPE* dataPtr;
-    if constexpr(std::is_same<THE_DOOCS_TYPE, DOOCS_PRIMITIVE_T>::value) {
-      // No cast necessary if types are identical.
-      dataPtr = _processArray.data();
-    }
-    else if constexpr(std::is_same<DOOCS_PRIMITIVE_T, ChimeraTK::Boolean>::value &&
-        std::is_same<THE_DOOCS_TYPE, bool>::value) {
-      // FIXME: Is it really ok to use reinterpret_cast here?
-      static_assert(sizeof(ChimeraTK::Boolean) == sizeof(bool));
-      dataPtr = reinterpret_cast<bool*>(_processArray.data());
-    }
-    else {
-      static_assert(std::is_same<THE_DOOCS_TYPE, DOOCS_PRIMITIVE_T>::value, "Bad type casting.");
+    const std::vector<DOOCS_PRIMITIVE_T>& data = _processArray;
+    if(isUnchanged(data, _processArray.dataValidity())) {
+      return;
     }
 
     if(_processArray.dataValidity() != ChimeraTK::DataValidity::ok) {
@@ -143,8 +151,7 @@ namespace ChimeraTK {
       this->d_error(no_error);
     }
 
-    this->fill_array(dataPtr, _processArray.getNElements());
-    modified = true;
+    fillDoocsBufferOrDefer();
 
     doocs::Timestamp timestamp = correctDoocsTimestamp();
 
@@ -157,6 +164,29 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  template<typename DOOCS_T, typename DOOCS_PRIMITIVE_T>
+  void DoocsProcessArray<DOOCS_T, DOOCS_PRIMITIVE_T>::fillDoocsBuffer() {
+    THE_DOOCS_TYPE* dataPtr;
+    if constexpr(std::is_same<THE_DOOCS_TYPE, DOOCS_PRIMITIVE_T>::value) {
+      // No cast necessary if types are identical.
+      dataPtr = _processArray.data();
+    }
+    else if constexpr(std::is_same<DOOCS_PRIMITIVE_T, ChimeraTK::Boolean>::value &&
+        std::is_same<THE_DOOCS_TYPE, bool>::value) {
+      // FIXME: Is it really ok to use reinterpret_cast here?
+      static_assert(sizeof(ChimeraTK::Boolean) == sizeof(bool));
+      dataPtr = reinterpret_cast<bool*>(_processArray.data());
+    }
+    else {
+      static_assert(std::is_same<THE_DOOCS_TYPE, DOOCS_PRIMITIVE_T>::value, "Bad type casting.");
+    }
+
+    this->fill_array(dataPtr, _processArray.getNElements());
+    modified = true;
+  }
+
+  /********************************************************************************************************************/
+
   template<typename DOOCS_T, typename DOOCS_PRIMITIVE_T>
   void DoocsProcessArray<DOOCS_T, DOOCS_PRIMITIVE_T>::sendToDevice(bool getLocks) {
     sendArrayToDevice(this, _processArray);
@@ -13,7 +13,9 @@
 #include <eq_fct.h>
 
 #include <chrono>
+#include <cmath>
 #include <string>
+#include <type_traits>
 
 namespace ChimeraTK {
 
@@ -45,7 +47,14 @@ namespace ChimeraTK {
     void auto_init() override;
 
    protected:
-    void updateDoocsBuffer(const TransferElementID& transferElementId) override;
+    void updateDoocsBuffer(const TransferElementID& transferElementId) final;
+
+    void writeHistoryEntry(const HistoryDecimator::Sample& sample) override;
+
+    // called by the DoocsUpdater instead of the virtual updateDoocsBuffer(), see PropertyBase::_updateThunk
+    static void updateDoocsBufferDirect(PropertyBase* property, const TransferElementID& transferElementId) {
+      static_cast<DoocsProcessScalar*>(property)->DoocsProcessScalar::updateDoocsBuffer(transferElementId);
+    }
 
     ScalarRegisterAccessor<T> _processScalar;
   };
@@ -58,6 +67,7 @@ namespace ChimeraTK {
       DataConsistencyGroup::MatchingMode matchingMode)
   : DOOCS_T(eqFct, doocsPropertyName), PropertyBase(doocsPropertyName, updater, matchingMode),
     _processScalar(processScalar) {
+    _updateThunk = &DoocsProcessScalar::updateDoocsBufferDirect;
     setupOutputVar(_processScalar);
   }
 
@@ -69,6 +79,7 @@ namespace ChimeraTK {
       DataConsistencyGroup::MatchingMode matchingMode)
   : DOOCS_T(doocsPropertyName, eqFct), PropertyBase(doocsPropertyName, updater, matchingMode),
     _processScalar(processScalar) {
+    _updateThunk = &DoocsProcessScalar::updateDoocsBufferDirect;
     setupOutputVar(_processScalar);
   }
 
@@ -134,6 +145,12 @@ namespace ChimeraTK {
     // DoocsUpdater
     T data = _processScalar;
 
+    if constexpr(std::is_arithmetic_v<T>) {
+      if(_deadband.isInside({static_cast<double>(data)}, _processScalar.dataValidity())) {
+        return;
+      }
+    }
+
     auto archiverStatus = ArchiveStatus::sts_ok;
     if(_processScalar.dataValidity() != ChimeraTK::DataValidity::ok) {
       archiverStatus = ArchiveStatus::sts_err;
@@ -150,10 +167,62 @@ namespace ChimeraTK {
     if(_macroPulseNumberSource.isInitialised()) {
       eventId = doocs::EventId(_macroPulseNumberSource);
     }
+
+    if constexpr(std::is_arithmetic_v<T>) {
+      if(_historyDecimator.isActive()) {
+        // Only the aggregated samples go into the history, see HistoryDecimator. writeHistoryEntry() leaves the
+        // published value unchanged, the new value is published afterwards.
+        auto sample = _historyDecimator.add({static_cast<double>(data)}, archiverStatus != ArchiveStatus::sts_ok,
+            timestamp.to_time_point(), _macroPulseNumberSource.isInitialised() ? int64_t(_macroPulseNumberSource) : 0);
+        if(sample) {
+          writeHistoryEntry(*sample);
+        }
+        this->set_value(data);
+        DOOCS_T::set_timestamp(timestamp);
+        if(_macroPulseNumberSource.isInitialised()) {
+          this->set_mpnum(_macroPulseNumberSource);
+        }
+        sendZMQ(timestamp);
+        return;
+      }
+    }
+
     this->set_value(data, timestamp, eventId, archiverStatus);
     sendZMQ(timestamp);
   }
 
   /********************************************************************************************************************/
 
+  template<typename T, typename DOOCS_T>
+  void DoocsProcessScalar<T, DOOCS_T>::writeHistoryEntry(const HistoryDecimator::Sample& sample) {
+    if constexpr(std::is_arithmetic_v<T>) {
+      T aggregated;
+      if constexpr(std::is_integral_v<T>) {
+        aggregated = static_cast<T>(std::llround(sample.values[0]));
+      }
+      else {
+        aggregated = static_cast<T>(sample.values[0]);
+      }
+      doocs::EventId eventId;
+      if(_macroPulseNumberSource.isInitialised()) {
+        eventId = doocs::EventId(sample.eventId);
+      }
+
+      // DOOCS writes the history of scalars only in the time stamped set_value(), which also sets the value. Hence
+      // the published value is restored afterwards. Clients cannot see the aggregated value, since both happen while
+      // holding the location lock. The published value is always the last added sample, see HistoryDecimator.
+      T published = DOOCS_T::value();
+      auto publishedTimestamp = DOOCS_T::get_timestamp();
+      this->set_value(aggregated, doocs::Timestamp(sample.time), eventId,
+          sample.isFaulty ? ArchiveStatus::sts_err : ArchiveStatus::sts_ok);
+      this->set_value(published);
+      DOOCS_T::set_timestamp(publishedTimestamp);
+      if(_macroPulseNumberSource.isInitialised()) {
+        this->set_mpnum(sample.eventId);
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
 } // namespace ChimeraTK
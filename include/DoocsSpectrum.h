@@ -60,6 +60,15 @@ namespace ChimeraTK {
      */
     void set(EqAdr* eqAdr, doocs::EqData* data1, doocs::EqData* data2, EqFct* eqFct) override;
 
+    /**
+     * Override the Doocs get method which is called for RPC reads, to fill the DOOCS buffer first if a lazy update is
+     * pending (see PropertyBase::setLazy()). DOOCS calls it with the location lock held.
+     */
+    void get(EqAdr* eqAdr, doocs::EqData* data1, doocs::EqData* data2, EqFct* eqFct) override {
+      materialiseLazyUpdate();
+      D_spectrum::get(eqAdr, data1, data2, eqFct);
+    }
+
     /**
      * Override the Doocs auto_init() method, which is called after initialising
      * the value of the property from the config file.
@@ -71,6 +80,9 @@ namespace ChimeraTK {
 
     void write(std::ostream& s) override;
 
+    /// Pointer to the contiguous data of an unbuffered spectrum, nullptr for buffered spectra
+    const float* getSpectrumData() { return _nBuffers == 1 ? spectrum()->d_spect_array.d_spect_array_val : nullptr; }
+
    protected:
     void addParameterAccessors();
     /// callback function after the start or increment variables have changed
@@ -80,6 +92,12 @@ namespace ChimeraTK {
     /// unit testing.
     void sendToDevice(bool getLock);
 
+    /// Fill the DOOCS buffer of an unbuffered spectrum, buffered spectra are always filled directly
+    void fillDoocsBuffer() override;
+    bool supportsLazyUpdate() override { return _nBuffers == 1 && !_processArray.isWriteable(); }
+    // buffered spectra need every update, since each macro pulse has its own buffer
+    bool supportsSuppressUnchanged() override { return _nBuffers == 1; }
+
    public:
     /// Flag whether the value has been modified since the content has been saved to disk the last time (see write()).
     bool modified{false};
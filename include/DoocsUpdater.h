@@ -3,27 +3,65 @@
 #pragma once
 
 #include "ChimeraTK/TypeChangingDecorator.h"
+#include "ConvertingDecorator.h"
 #include "DoocsAdapter.h"
 #include "RoutingDecorator.h"
+#include "UpdaterConfig.h"
 
+#include <ChimeraTK/ReadAnyGroup.h>
 #include <ChimeraTK/TransferElement.h>
 #include <ChimeraTK/TransferElementAbstractor.h>
 
 #include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
 
 #include <eq_fct.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <map>
+#include <set>
+#include <tuple>
+#include <typeindex>
 #include <utility>
+#include <vector>
 
 namespace ChimeraTK {
 
   /** A class to synchronise DeviceToControlSystem variable to Doocs.
-   *  It contains a list of TransferElements and a thread which is monitoring them
-   * for updates. The thread has to be started with the run() functions, which
-   * returns immediately when the thread is started, and (FIXME can be stopped by
-   * the stop() function which returns after the thread has been joined). This
+   *  It contains a list of TransferElements and one or more threads which are monitoring them
+   * for updates. The threads have to be started with the run() functions, which
+   * returns immediately when the threads are started, and (FIXME can be stopped by
+   * the stop() function which returns after the threads have been joined). This
    * happens latest in the destructor.
+   *
+   * If more than one thread is configured (see UpdaterConfig::nThreads), the locations are distributed over the
+   * threads. Locations sharing a process variable are always handled by the same thread, so each thread owns a
+   * disjoint set of locations and its own ReadAnyGroup.
+   *
+   * Locations listed in UpdaterConfig::eventBuilderTimeouts have an event builder: their updates are collected until
+   * each variable of the location has been updated once (or until the timeout expires) and then all are applied
+   * under a single location lock, see EventBuilder.
+   *
+   * If any variable has a priority class other than UpdatePriority::normal (see setPriority()) or a fairness limit is
+   * configured (see UpdaterConfig::fairnessLimit), the pending notifications are scheduled: in each round, all pending
+   * notifications are collected from the ReadAnyGroup, and up to UpdaterConfig::batchSize notifications are processed,
+   * highest priority class first and in the order of arrival within a class. A variable which has been processed
+   * fairnessLimit times in a row while other variables were waiting is skipped for one round. The time the
+   * notifications spent waiting for their round is recorded per class, see getWaitTimeStatistics().
+   *
+   * With UpdaterConfig::deferBusyLocations, the location locks are taken with try_lock(). If a location is busy (e.g.
+   * an RPC thread serves a large array), the notification is parked and the updater continues with other
+   * notifications. All further notifications sharing any location with a parked notification are parked behind it,
+   * so the order of the updates within each location is kept. The parked notifications are retried before each new
+   * batch and periodically while waiting. The time spent parked is recorded per location, see
+   * getParkedTimeStatistics(). Event builders still wait for the location lock.
+   *
+   * With UpdaterConfig::asyncPropagation, a separate thread applies changes written via RPC to process variables shared
+   * by several properties (see PropertyBase::updateOthers()). The RPC thread only queues the changed property. All
+   * properties queued while the thread was busy are handled in one batch, each property only once.
    */
   class DoocsUpdater : public boost::noncopyable {
    public:
@@ -41,18 +79,51 @@ namespace ChimeraTK {
     void run();
     void stop();
 
+    /// Set the configuration. Must be called before run().
+    void setConfig(const UpdaterConfig& config) { _config = config; }
+    [[nodiscard]] const UpdaterConfig& getConfig() const { return _config; }
+
     /**
      * Add a variable to be updated. Together with the TransferElementAbstractor pointing to the
      * ChimeraTK::ProcessArray, the EqFct* to obtain the lock for and a function to be called which executes the actual
      * update should be specified. The lock is held while read operations are executed on the accessor and while the
      * updaterFunction is called, so it must neither obtained nor released within the updaterFunction.
      * updateFunction can be empty, in case the variable is used by only by other updaterFunctions.
+     *
+     * If the property owning the updaterFunction is given, the updater may evaluate its data consistency before
+     * taking the location lock (see PropertyBase::precheckConsistency()). The location is then locked and the
+     * updaterFunction called only if the data is consistent.
      */
     void addVariable(const ChimeraTK::TransferElementAbstractor& variable, EqFct* eq_fct,
-        const std::function<void()>& updaterFunction = {});
+        const std::function<void()>& updaterFunction = {}, PropertyBase* property = nullptr);
+
+    /// Add a variable whose updates are processed by calling the given function with the property and the ID of the
+    /// variable. This avoids the overhead of the std::function on each update. See addVariable() above.
+    void addVariable(const ChimeraTK::TransferElementAbstractor& variable, EqFct* eq_fct,
+        PropertyBase::UpdateThunk updateThunk, PropertyBase* property);
 
     const std::list<ChimeraTK::TransferElementAbstractor>& getElementsToRead() { return _elementsToRead; }
 
+    /**
+     * Add a property with a rate limit (see PropertyBase::setMaxRate()). While the updater is running, a separate
+     * thread periodically publishes conflated updates of these properties, so the latest value is never lost.
+     */
+    void addRateLimitedProperty(PropertyBase* property);
+
+    /**
+     * Add a property with history decimation (see PropertyBase::setHistoryDecimation()). While the updater is running,
+     * the same thread periodically writes the history entry of intervals which have ended without a further update.
+     */
+    void addDecimatedProperty(PropertyBase* property);
+
+    /// Returns whether changes of shared writeable process variables are propagated by a separate thread, see
+    /// UpdaterConfig::asyncPropagation. Only true while running.
+    [[nodiscard]] bool isPropagationAsync() const { return _propagationActive; }
+
+    /// Queue the property for calling PropertyBase::propagateChange() in the propagation thread. Must only be called
+    /// while isPropagationAsync() returns true.
+    void queuePropagation(boost::shared_ptr<PropertyBase> property);
+
     RoutingDecoratorDomain routing;
 
     template<typename UserType>
@@ -63,19 +134,304 @@ namespace ChimeraTK {
     // For readable process variables, checks if fan-out is required and returns mapped output.
     // Write-only process variables are handed through.
     TransferElement::SharedPtr getMappedProcessVariableUnTyped(const ChimeraTK::RegisterPath& processVariableName);
+
+    /**
+     * Return the accessor for a macro pulse number source used by a property in the given location. Unless the
+     * property uses historized data matching, all properties of the same location share one accessor. It is read only
+     * once per macro pulse, and the single notification feeds the value and version number to all consistency groups
+     * of these properties. Historized data matching decorates the accessor inside the DataConsistencyGroup, so these
+     * properties obtain an accessor of their own.
+     */
+    boost::shared_ptr<NDRegisterAccessor<int64_t>> getMacroPulseNumberSource(const ChimeraTK::RegisterPath& sourcePath,
+        EqFct* location, DataConsistencyGroup::MatchingMode matchingMode);
     void setPvNamesWithFan(std::set<std::string> pvNamesWithFan) { _pvNamesWithFan = std::move(pvNamesWithFan); }
 
+    /**
+     * Set the queue settings of the PVs, see QueueConfig. Must be called before the accessors are obtained. PVs with a
+     * depth above zero must be in the list of PVs with fan (see setPvNamesWithFan()), since the queue is provided by
+     * the copy of the fan-out. The policy applies to the accessors returned by getMappedProcessVariable(), except for
+     * accessors whose updates are bundled into events (see UpdaterConfig::eventBuilderTimeouts).
+     */
+    void setQueueConfigs(std::map<std::string, QueueConfig> queueConfigs) { _queueConfigs = std::move(queueConfigs); }
+
+    /// Number of updates skipped by the queue policy QueuePolicy::latest, since a newer update was already pending
+    [[nodiscard]] size_t getNumberOfSkippedUpdates() const { return _nSkippedUpdates; }
+
+    /// Number of rounds in which the update loop locked the locations of a batch of notifications at once (see
+    /// UpdaterConfig::batchSize), and the number of notifications handled in these rounds. Without batching, both
+    /// numbers are equal. Prechecked single notifications, events and parked notifications are not counted.
+    struct BatchStatistics {
+      size_t nLockRounds{0};
+      size_t nNotifications{0};
+    };
+    [[nodiscard]] BatchStatistics getBatchStatistics() const { return {_nLockRounds, _nBatchedNotifications}; }
+
+    /// Raise the priority class of the given variable to at least the given priority. The priorities of the properties
+    /// given to addVariable() are taken into account automatically. Must be called before run().
+    void setPriority(const ChimeraTK::TransferElementID& id, UpdatePriority priority);
+
+    /// Time which notifications of one priority class spent waiting to be scheduled, see class description. Only
+    /// recorded while scheduling is active.
+    struct WaitTimeStatistics {
+      size_t nUpdates{0};
+      std::chrono::microseconds total{0};
+      std::chrono::microseconds max{0};
+    };
+    [[nodiscard]] WaitTimeStatistics getWaitTimeStatistics(UpdatePriority priority) const;
+
+    /// Time from the creation of the version number of an update until its update functions are called. Only recorded
+    /// if UpdaterConfig::measureLatency is set. This includes the time the application needs between creating the
+    /// version number and writing the update, which is usually small.
+    [[nodiscard]] WaitTimeStatistics getLatencyStatistics() const { return getStatistics(_latency); }
+
+    /// Time which notifications spent parked because the location was busy, see UpdaterConfig::deferBusyLocations.
+    /// Must not be called before run().
+    [[nodiscard]] WaitTimeStatistics getParkedTimeStatistics(EqFct* location) const;
+
+    /// Set the PVs for which getMappedProcessVariable() returns the same accessor to all consumers requesting the same
+    /// type, see UpdaterConfig::directDispatch. The consumers must not decorate or modify the accessor.
+    void setPvNamesWithDirectDispatch(std::set<std::string> pvNamesWithDirectDispatch) {
+      _pvNamesWithDirectDispatch = std::move(pvNamesWithDirectDispatch);
+    }
+
    protected:
     boost::shared_ptr<ControlSystemPVManager> _controlSystemPVManager;
     std::set<std::string> _pvNamesWithFan;
+    std::set<std::string> _pvNamesWithDirectDispatch;
+    std::map<std::string, QueueConfig> _queueConfigs;
+    // accessors with the queue policy QueuePolicy::latest
+    std::set<ChimeraTK::TransferElementID> _latestPolicyIds;
+    std::atomic<size_t> _nSkippedUpdates{0};
+    // see getBatchStatistics()
+    std::atomic<size_t> _nLockRounds{0};
+    std::atomic<size_t> _nBatchedNotifications{0};
+
+    // wait times per priority class, see getWaitTimeStatistics()
+    static constexpr size_t nPriorities{3};
+    struct WaitTimeCounters {
+      std::atomic<size_t> nUpdates{0};
+      std::atomic<int64_t> totalMicroseconds{0};
+      std::atomic<int64_t> maxMicroseconds{0};
+    };
+    std::array<WaitTimeCounters, nPriorities> _waitTimes;
+    // see getLatencyStatistics()
+    WaitTimeCounters _latency;
+    // parked times per location, see getParkedTimeStatistics(). Filled before the update threads are started.
+    std::map<EqFct*, WaitTimeCounters> _parkedTimes;
+
+    static void recordWaitTime(WaitTimeCounters& counters, std::chrono::nanoseconds waitTime);
+    static WaitTimeStatistics getStatistics(const WaitTimeCounters& counters);
+
+    // interval for retrying parked notifications while waiting for new notifications
+    static constexpr std::chrono::microseconds parkedRetryInterval{100};
+    // accessors shared between the consumers of PVs in _pvNamesWithDirectDispatch, by PV name, type and decorator type
+    std::map<std::tuple<std::string, std::type_index, DecoratorType>, boost::shared_ptr<TransferElement>>
+        _directDispatchAccessors;
+    std::map<std::pair<std::string, EqFct*>, boost::shared_ptr<NDRegisterAccessor<int64_t>>>
+        _sharedMacroPulseNumberSources;
     std::list<ChimeraTK::TransferElementAbstractor> _elementsToRead;
-    boost::thread _syncThread; // we have to use boost thread to use interruption points
+    UpdaterConfig _config;
+
+    // Update function given to addVariable(), either as a plain function with its arguments or as a std::function
+    struct UpdateFunction {
+      PropertyBase::UpdateThunk thunk{nullptr};
+      PropertyBase* property{nullptr};
+      ChimeraTK::TransferElementID id;
+      std::function<void()> function;
+
+      void operator()() const {
+        if(thunk) {
+          thunk(property, id);
+        }
+        else {
+          function();
+        }
+      }
+    };
+
+    // Entry of the dispatch table used in the updateLoop. The table is indexed by the position of the element in the
+    // ReadAnyGroup (cf. ReadAnyGroup::Notification::getIndex()), so no lookup by TransferElementID is required when
+    // an update arrives.
+    struct DispatchEntry {
+      static constexpr size_t noEventBuilder{std::numeric_limits<size_t>::max()};
+
+      ChimeraTK::TransferElementID id;
+      bool isFanSource{false};
+      // unique locations, sorted by address so all threads lock them in the same order
+      std::vector<EqFct*> locations;
+      std::vector<UpdateFunction> updateFunctions;
+      // properties owning the updateFunctions (same index), if the consistency is evaluated before locking
+      std::vector<PropertyBase*> properties;
+      bool canPrecheck{false};
+      // indices of updateFunctions with consistent data, see dispatchPrechecked()
+      std::vector<size_t> readyFunctions;
+      // index into UpdatePartition::eventBuilders, if the updates are bundled into events
+      size_t eventBuilder{noEventBuilder};
+      // whether a notification of this entry is part of the event currently being built
+      bool isEventPending{false};
+      // whether only the newest of several pending notifications is dispatched, see QueuePolicy::latest
+      bool collapseBacklog{false};
+      // number of notifications of this entry in the current batch, only counted if collapseBacklog is set
+      size_t nInBatch{0};
+      // scheduling state, see schedule()
+      UpdatePriority priority{UpdatePriority::normal};
+      size_t nPending{0};
+      size_t nConsecutive{0};
+      bool hasYielded{false};
+    };
+
+    // Bundles the updates of one location. The notifications are kept without accepting them, so the accessors still
+    // hold the data of the previous event. The event is complete when each entry of the location has a notification,
+    // when a second notification for an entry arrives (which then starts the next event), or when the timeout has
+    // expired. All notifications of the event are then accepted and dispatched under a single location lock.
+    struct EventBuilder {
+      EqFct* location{nullptr};
+      std::chrono::microseconds timeout{0};
+      size_t nEntries{0};
+      std::vector<ReadAnyGroup::Notification> pending;
+      std::chrono::steady_clock::time_point deadline;
+    };
+
+    // Subset of _elementsToRead handled by one update thread, together with its dispatch table
+    struct UpdatePartition {
+      std::list<ChimeraTK::TransferElementAbstractor> elementsToRead;
+      std::vector<DispatchEntry> dispatchTable;
+      std::vector<EventBuilder> eventBuilders;
+      // interval for polling new notifications while events are incomplete, so timeouts can be detected
+      std::chrono::microseconds eventPollInterval{0};
+      // whether any entry has collapseBacklog set
+      bool hasCollapsingEntries{false};
+      // whether the notifications are scheduled by priority and fairness, see schedule()
+      bool isScheduled{false};
+      struct PendingNotification {
+        ReadAnyGroup::Notification notification;
+        std::chrono::steady_clock::time_point since;
+      };
+      // notifications waiting to be scheduled, per priority class in the order of arrival
+      std::array<std::vector<PendingNotification>, nPriorities> pending;
+      size_t nPending{0};
+      // buffers reused by schedule()
+      std::vector<PendingNotification> kept;
+      std::vector<size_t> yielded;
+      // notifications waiting for a busy location, see UpdaterConfig::deferBusyLocations, in the order of arrival. A
+      // notification stays parked while any of its locations is busy or used by an older parked notification, so the
+      // order of the updates is kept for each location. The vectors are swapped when retrying, so both keep their
+      // capacity and parking does not allocate once they have grown to their typical size.
+      struct ParkedNotification {
+        ReadAnyGroup::Notification notification;
+        std::chrono::steady_clock::time_point since;
+        // the location which was busy or used by an older parked notification, for getParkedTimeStatistics()
+        EqFct* busyLocation{nullptr};
+        // whether a newer notification of the same accessor is pending, see QueuePolicy::latest
+        bool isSuperseded{false};
+      };
+      std::vector<ParkedNotification> parked;
+      std::vector<ParkedNotification> keptParked;
+      // locations of the parked notifications, collected by dispatchDeferred()
+      std::vector<EqFct*> parkedLocations;
+      // locations locked by dispatchDeferred()
+      std::vector<EqFct*> lockedLocations;
+    };
+
+    // One thread per partition of _elementsToRead. We have to use boost thread to use interruption points.
+    std::vector<boost::thread> _syncThreads;
+    std::vector<UpdatePartition> _partitions;
+
+    // Create a new (typed) accessor for the PV, with fan-out if required
+    template<typename UserType>
+    boost::shared_ptr<NDRegisterAccessor<UserType>> createMappedProcessVariable(
+        const ChimeraTK::RegisterPath& processVariableName, DecoratorType decoratorType);
+
+    // Fill the dispatch table of the partition from its elementsToRead. Must be called before the updateLoop is
+    // started, since it accesses the _toDoocsDescriptorMap.
+    void buildDispatchTable(UpdatePartition& partition);
+
+    // Endless update loop for the given partition.
+    void updateLoop(UpdatePartition& partition);
+
+    // Common part of the public addVariable() functions. The function is only registered if hasFunction is set.
+    void addVariable(const ChimeraTK::TransferElementAbstractor& variable, EqFct* eq_fct, UpdateFunction&& function,
+        bool hasFunction, PropertyBase* property);
+
+    // Apply the CPU affinity and real-time priority from the config to the calling update thread
+    void configureUpdateThread(size_t threadIndex);
+
+    // Record the latency of an update with the given version number, if UpdaterConfig::measureLatency is set
+    void recordLatency(const VersionNumber& version);
+
+    // Wait for the next notification, polling for UpdaterConfig::spinTime before blocking
+    ReadAnyGroup::Notification waitAny(ReadAnyGroup& group);
+
+    // Accept the notification and call the update functions of the entry (or generate the copies for a fan source).
+    // The locations of the entry must be locked.
+    void dispatch(DispatchEntry& entry, ReadAnyGroup::Notification& notification);
+
+    // Move the notifications of the batch and all notifications pending in the group into the partition's pending
+    // lists, then select the notifications of the next round into the batch. The batch may remain empty if all
+    // waiting variables have reached the fairness limit.
+    void schedule(UpdatePartition& partition, ReadAnyGroup& group, std::vector<ReadAnyGroup::Notification>& batch);
+
+    // Dispatch the parked notifications whose locations are available, then the notifications of the batch, taking the
+    // location locks with try_lock(). Notifications for busy locations are parked. See
+    // UpdaterConfig::deferBusyLocations.
+    void dispatchDeferred(UpdatePartition& partition, std::vector<ReadAnyGroup::Notification>& batch);
+
+    // Try to lock all given locations which are not yet in the locked list. Returns the first busy location, or nullptr
+    // if all locations are locked. Locations locked successfully are added to the list in any case.
+    static EqFct* tryLock(const std::vector<EqFct*>& locations, std::vector<EqFct*>& locked);
+
+    // Accept the notification without calling the update functions, since a newer notification of the entry is
+    // already pending. The locations of the entry must be locked.
+    void skip(ReadAnyGroup::Notification& notification);
+
+    // Accept the notification and evaluate the data consistency of the properties without the location lock. Only
+    // if any property has consistent data, the locations are locked and the update functions of these properties are
+    // called. Only allowed for entries with canPrecheck set.
+    void dispatchPrechecked(DispatchEntry& entry, ReadAnyGroup::Notification& notification);
+
+    // Add the notification to the event of the entry's location, and dispatch the event if it is complete
+    void addToEvent(UpdatePartition& partition, DispatchEntry& entry, ReadAnyGroup::Notification&& notification);
+
+    // Dispatch all notifications of the event under the location lock
+    void dispatchEvent(UpdatePartition& partition, EventBuilder& builder);
+
+    // Dispatch all incomplete events whose timeout has expired
+    void dispatchExpiredEvents(UpdatePartition& partition);
+
+    // Rate-limited and decimated properties and the shortest of their intervals, see addRateLimitedProperty() and
+    // addDecimatedProperty()
+    std::vector<PropertyBase*> _rateLimitedProperties;
+    std::vector<PropertyBase*> _decimatedProperties;
+    std::chrono::steady_clock::duration _minFlushInterval{std::chrono::steady_clock::duration::max()};
+
+    // Endless loop publishing conflated updates of the rate-limited properties and finishing the history intervals of
+    // the decimated properties
+    void flushLoop();
+
+    // Properties with changes to propagate, see queuePropagation(). Protected by _propagationMutex.
+    std::vector<boost::shared_ptr<PropertyBase>> _propagationQueue;
+    boost::mutex _propagationMutex;
+    boost::condition_variable _propagationQueueNotEmpty;
+    std::atomic<bool> _propagationActive{false};
+
+    // Endless loop propagating the queued changes in batches
+    void propagationLoop();
+
+    // Split _elementsToRead into at most nPartitions lists, such that no location is used by elements of different
+    // lists. Elements without a location (e.g. sources of fan-outs) are added to the smallest list. Empty lists are
+    // not returned.
+    std::vector<std::list<ChimeraTK::TransferElementAbstractor>> partitionElementsToRead(size_t nPartitions);
 
     // Struct used to aggregate the information needed in the updateLoop when an update is received from the
     // application.
     struct ToDoocsUpdateDescriptor {
-      std::vector<std::function<void()>> updateFunctions;
+      std::vector<UpdateFunction> updateFunctions;
+      std::vector<PropertyBase*> properties;
+      // false if any user of the variable did not give its property to addVariable()
+      bool allPropertiesKnown{true};
       std::vector<EqFct*> locations;
+      // raised by setPriority()
+      UpdatePriority priority{UpdatePriority::normal};
     };
     std::map<ChimeraTK::TransferElementID, ToDoocsUpdateDescriptor> _toDoocsDescriptorMap;
   };
@@ -85,6 +441,24 @@ namespace ChimeraTK {
   template<typename UserType>
   boost::shared_ptr<NDRegisterAccessor<UserType>> DoocsUpdater::getMappedProcessVariable(
       const RegisterPath& processVariableName, DecoratorType decoratorType) {
+    if(!_pvNamesWithDirectDispatch.empty()) {
+      auto pvName = _controlSystemPVManager->getProcessVariable(processVariableName)->getName();
+      if(_pvNamesWithDirectDispatch.contains(pvName)) {
+        auto& sharedAccessor = _directDispatchAccessors[{pvName, typeid(UserType), decoratorType}];
+        if(!sharedAccessor) {
+          sharedAccessor = createMappedProcessVariable<UserType>(processVariableName, decoratorType);
+        }
+        return boost::static_pointer_cast<NDRegisterAccessor<UserType>>(sharedAccessor);
+      }
+    }
+    return createMappedProcessVariable<UserType>(processVariableName, decoratorType);
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  boost::shared_ptr<NDRegisterAccessor<UserType>> DoocsUpdater::createMappedProcessVariable(
+      const RegisterPath& processVariableName, DecoratorType decoratorType) {
     auto pv = getMappedProcessVariableUnTyped(processVariableName);
     if(typeid(UserType) == pv->getValueType()) {
       return boost::dynamic_pointer_cast<NDRegisterAccessor<UserType>>(pv);
@@ -96,6 +470,13 @@ namespace ChimeraTK {
           std::string("DoocsUpdater::getMappedProcessVariable: processArray is not of string type: ") + pv->getName());
     }
     else {
+      // use the faster converter for numeric types, it gives the same results as the C_style_conversion
+      if(decoratorType == DecoratorType::C_style_conversion) {
+        auto converted = getConvertingDecorator<UserType>(pv);
+        if(converted) {
+          return converted;
+        }
+      }
       return getTypeChangingDecorator<UserType>(pv, decoratorType);
     }
   }
@@ -24,6 +24,7 @@ namespace ChimeraTK {
 
    protected:
     void updateDoocsBuffer(const TransferElementID& elementId) override;
+    bool supportsSuppressUnchanged() override { return true; }
 
     OneDRegisterAccessor<float> _xValues;
     OneDRegisterAccessor<float> _yValues;
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace ChimeraTK {
+
+  /// How the samples of one interval are combined into one history entry by the HistoryDecimator
+  enum class HistoryAggregation { last, min, max, mean };
+
+  /**
+   * Reduces the rate of history entries of a property. All samples arriving within one interval of 1/maxRate are
+   * aggregated (per component, for tuples like D_ifff) into one history entry. The very first sample is returned
+   * immediately, so the history starts with the initial value. An interval starts with its first sample and is
+   * finished by the first sample arriving after its end, which is not part of it but starts the next interval. If no
+   * further sample arrives, the interval is finished by flush(), which is called periodically by the DoocsUpdater.
+   */
+  class HistoryDecimator {
+   public:
+    using Clock = std::chrono::system_clock;
+
+    HistoryDecimator() = default;
+    HistoryDecimator(double maxRate, HistoryAggregation aggregation) : _aggregation(aggregation) {
+      if(maxRate > 0.) {
+        _interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1. / maxRate));
+      }
+    }
+
+    /// Returns whether decimation is configured
+    [[nodiscard]] bool isActive() const { return _interval > Clock::duration::zero(); }
+
+    /// Length of the aggregation interval
+    [[nodiscard]] Clock::duration getInterval() const { return _interval; }
+
+    /// One aggregated sample. isFaulty is set if any of the aggregated samples was faulty. time and eventId are those
+    /// of the last aggregated sample.
+    struct Sample {
+      std::vector<double> values;
+      bool isFaulty{false};
+      Clock::time_point time;
+      int64_t eventId{0};
+    };
+
+    /// Add a sample with the given time stamp and event ID (e.g. the macro pulse number). Returns the aggregated
+    /// sample if a history entry shall be written now, nullptr otherwise. The returned sample is only valid until the
+    /// next call to add() or flush(), it is reused to avoid allocations.
+    const Sample* add(
+        std::initializer_list<double> values, bool isFaulty, Clock::time_point time, int64_t eventId = 0) {
+      if(_isFirst) {
+        _isFirst = false;
+        _finished.values.assign(values);
+        _finished.isFaulty = isFaulty;
+        _finished.time = time;
+        _finished.eventId = eventId;
+        return &_finished;
+      }
+
+      // the boundary is checked before aggregating, since this sample belongs to the next interval
+      const Sample* finished = flush(time);
+
+      if(_nSamples == 0) {
+        _intervalStart = time;
+        _sample.values.assign(values);
+        _sample.isFaulty = isFaulty;
+      }
+      else {
+        aggregate(values, isFaulty);
+      }
+      _sample.time = time;
+      _sample.eventId = eventId;
+      ++_nSamples;
+      return finished;
+    }
+
+    /// Finish the current interval, if it has ended at the given time. Returns the aggregated sample if a history
+    /// entry shall be written now, nullptr otherwise. Same validity of the returned sample as for add().
+    const Sample* flush(Clock::time_point now) {
+      if(_nSamples == 0 || now < _intervalStart + _interval) {
+        return nullptr;
+      }
+      // swap instead of copy, so both buffers keep their capacity
+      std::swap(_sample, _finished);
+      if(_aggregation == HistoryAggregation::mean) {
+        for(auto& value : _finished.values) {
+          value /= double(_nSamples);
+        }
+      }
+      _nSamples = 0;
+      return &_finished;
+    }
+
+   protected:
+    void aggregate(std::initializer_list<double> values, bool isFaulty) {
+      _sample.isFaulty = _sample.isFaulty || isFaulty;
+      auto target = _sample.values.begin();
+      for(auto value = values.begin(); value != values.end() && target != _sample.values.end(); ++value, ++target) {
+        switch(_aggregation) {
+          case HistoryAggregation::last:
+            *target = *value;
+            break;
+          case HistoryAggregation::min:
+            *target = std::min(*target, *value);
+            break;
+          case HistoryAggregation::max:
+            *target = std::max(*target, *value);
+            break;
+          case HistoryAggregation::mean:
+            *target += *value;
+            break;
+        }
+      }
+    }
+
+    Clock::duration _interval{Clock::duration::zero()};
+    HistoryAggregation _aggregation{HistoryAggregation::last};
+    Clock::time_point _intervalStart;
+    Sample _sample;   // the interval currently being aggregated
+    Sample _finished; // the last returned sample
+    size_t _nSamples{0};
+    bool _isFirst{true};
+  };
+
+} // namespace ChimeraTK
@@ -2,6 +2,10 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 #pragma once
 
+#include "DeadbandFilter.h"
+#include "HistoryDecimator.h"
+#include "UpdaterConfig.h"
+
 #include <ChimeraTK/ControlSystemAdapter/ControlSystemPVManager.h>
 #include <ChimeraTK/DataConsistencyGroup.h>
 #include <ChimeraTK/OneDRegisterAccessor.h>
@@ -9,7 +13,11 @@
 
 #include <eq_fct.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <functional>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -18,9 +26,14 @@ namespace ChimeraTK {
   class DoocsUpdater;
   class PropertyBase;
 
-  /// List of callbacks to be invoked when a shared PV changes. Each callback receives a flag indicating whether
-  /// locking is needed and a shared_ptr to the property that triggered the change.
-  using PVChangeListeners = std::vector<std::function<void(bool, const boost::shared_ptr<PropertyBase>&)>>;
+  /// Callback to be invoked when a shared PV changes. The callback receives a flag indicating whether locking is
+  /// needed and a shared_ptr to the property that triggered the change. location is the location the callback locks
+  /// if locking is needed.
+  struct PVChangeListener {
+    EqFct* location;
+    std::function<void(bool, const boost::shared_ptr<PropertyBase>&)> callback;
+  };
+  using PVChangeListeners = std::vector<PVChangeListener>;
 
   /**
    * Base class used for all properties.
@@ -32,10 +45,13 @@ namespace ChimeraTK {
     PropertyBase(std::string doocsPropertyName, DoocsUpdater& updater, DataConsistencyGroup::MatchingMode matchingMode);
     virtual ~PropertyBase() = default;
 
+    /// Function called by the DoocsUpdater for each update of a registered variable, see _updateThunk
+    using UpdateThunk = void (*)(PropertyBase* property, const TransferElementID& transferElementId);
+
     /// returns associated DOOCS location
-    EqFct* getEqFct() { return getDfct()->get_eqfct(); }
+    EqFct* getEqFct() { return _eqFct ? _eqFct : getDfct()->get_eqfct(); }
     /// returns associated DOOCS property. Not null.
-    D_fct* getDfct() { return dynamic_cast<D_fct*>(this); }
+    D_fct* getDfct() { return _dfct ? _dfct : dynamic_cast<D_fct*>(this); }
     /// turns on ZeroMQ publishing
     void publishZeroMQ() { _publishZMQ = true; }
     /// set macro pulse number source, if configured
@@ -46,10 +62,98 @@ namespace ChimeraTK {
     /// set the is-writeable source, if configured
     void setIsWriteableSource(const std::string& sourcePath);
 
+    /// Limit the rate (in Hz) at which updates from the application are published. Updates arriving faster are
+    /// conflated to the latest value, which is published by the DoocsUpdater after the interval has passed. A rate of
+    /// 0 means unlimited (the default).
+    void setMaxRate(double maxRate);
+
+    /// Publish a conflated update, if one is pending and the rate limit permits. Obtains the location lock, hence it
+    /// must be called without holding it. Called by the DoocsUpdater.
+    void flushConflatedUpdate();
+
+    /// Enable or disable lazy updates. If enabled, updateDoocsBuffer() does not copy the data into the DOOCS buffer,
+    /// but only marks it as outdated. The copy is done by materialiseLazyUpdate() when a client reads the property.
+    /// Lazy updates are not enabled if the property does not support them (see supportsLazyUpdate()), if it is
+    /// published via ZeroMQ or if it uses exact data matching with a macro pulse number source, since then the
+    /// accessor may already hold newer data than the published version. Must be called after the macro pulse number
+    /// source has been set.
+    void setLazy(bool lazy);
+
+    /// Returns whether lazy updates are enabled
+    [[nodiscard]] bool isLazy() const { return _lazy; }
+
+    /// Copy the data into the DOOCS buffer, if a lazy update is pending. Must be called with the location lock held.
+    void materialiseLazyUpdate();
+
+    /// Skip updates from the application which change neither the data nor its validity, see isUnchanged(). Has no
+    /// effect for properties which do not support it (see supportsSuppressUnchanged()).
+    void setSuppressUnchanged(bool suppress) { _suppressUnchanged = suppress && supportsSuppressUnchanged(); }
+
+    /// Set the deadband for updates from the application, see DeadbandFilter. Only used by property types with scalar
+    /// values (plain scalars, D_ifff and D_iiii).
+    void setDeadband(double absolute, double relative) { _deadband = DeadbandFilter(absolute, relative); }
+
+    /// Limit the rate (in Hz) of history entries, see HistoryDecimator. Only used by property types with scalar values
+    /// (plain scalars, D_ifff and D_iiii). A rate of 0 means every update is stored (the default).
+    void setHistoryDecimation(double maxRate, HistoryAggregation aggregation);
+
+    /// Write the history entry of the current aggregation interval, if the interval has ended without a further update
+    /// finishing it. Obtains the location lock, hence it must be called without holding it. Called by the DoocsUpdater.
+    void flushHistory();
+
+    /// Length of the history aggregation interval, see setHistoryDecimation()
+    [[nodiscard]] HistoryDecimator::Clock::duration getHistoryInterval() const {
+      return _historyDecimator.getInterval();
+    }
+
+    /// Set the priority class of the updates of this property in the DoocsUpdater. This includes the updates of the
+    /// is-writeable source, hence it must be called after setIsWriteableSource().
+    void setPriority(UpdatePriority priority);
+
+    [[nodiscard]] UpdatePriority getPriority() const { return _priority; }
+
+    /// Number of updates which have been dropped due to the rate limit, i.e. were superseded by a newer value
+    /// before being published.
+    [[nodiscard]] size_t getNumberOfConflatedUpdates() const { return _nConflatedUpdates; }
+
+    /// Number of updates which have been lost because the data matching failed, i.e. the main value was replaced by
+    /// a newer one before a consistent set of values was complete
+    [[nodiscard]] size_t getNumberOfDataLosses() const { return _nDataLossWarnings; }
+
+    /// Number of updates published with historized data matching, for which the consistent set of values was found in
+    /// the history because a partner (e.g. the macro pulse number) arrived late
+    [[nodiscard]] size_t getNumberOfHistorizedMatches() const { return _nHistorizedMatches; }
+
+    /// Minimum interval between two published updates, zero if not rate limited
+    [[nodiscard]] std::chrono::steady_clock::duration getMinUpdateInterval() const { return _minUpdateInterval; }
+
+    /// Function returning the current time for the rate limit, see setMaxRate()
+    using RateLimitClock = std::chrono::steady_clock::time_point (*)();
+
+    /// Replace the clock used for the rate limit. Only intended for testing, must be called before the first update.
+    void setRateLimitClock(RateLimitClock clock) { _now = clock; }
+
+    /// Returns whether the DoocsUpdater may complete read transfers of this property's variables and call
+    /// precheckConsistency() without holding the location lock. This requires that the accessors are not accessed by
+    /// other threads under the location lock, i.e. the property is not writeable, not lazy and not rate limited, and
+    /// that the data matching does not modify the accessors (as historized matching does). Called by the DoocsUpdater
+    /// when starting its threads.
+    bool allowsConsistencyPrecheck();
+
+    /// Evaluate the data consistency for an update of the given variable before the DoocsUpdater takes the location
+    /// lock. Returns true if the update function has to be called, which then skips the evaluation. Must only be
+    /// called by the DoocsUpdater thread owning the location, if allowsConsistencyPrecheck() returned true.
+    bool precheckConsistency(const TransferElementID& updatedId);
+
     /// Subscribe to change notifications on a shared process variable.
     /// When another property writes to the same PV, this property's DOOCS buffer gets updated.
     void subscribeToSharedPV(const std::string& pvName);
 
+    /// Apply a change of this property's PV to the other properties sharing it, see updateOthers(). Each listener runs
+    /// while holding both this property's location lock and the listener's location lock, hence it must be called
+    /// without holding any location lock. Called by the DoocsUpdater with UpdaterConfig::asyncPropagation.
+    void propagateChange();
+
     /// Check if other data properties need updating when this property's PV changes
     bool hasOtherPropertiesToUpdate() {
       callbacksOnChange();
@@ -80,10 +184,49 @@ namespace ChimeraTK {
     void setupOutputVar(TransferElementAbstractor& processVar);
 
     /// register a variable in consistency group
-    /// If update=true, updates are processed with our updateDoocsBuffer function.
+    /// If update=true, updates are processed with our updateDoocsBuffer function, called through _updateThunk.
     void registerVariable(TransferElementAbstractor& var, bool update = true);
-    /// update for data consistency group
+
+    /// Function registered with the DoocsUpdater to call updateDoocsBuffer(). The default calls the virtual function.
+    /// Frequently used property types replace it with a function calling their implementation directly, which must be
+    /// done before their variables are registered.
+    UpdateThunk _updateThunk{&PropertyBase::updateDoocsBufferVirtual};
+    static void updateDoocsBufferVirtual(PropertyBase* property, const TransferElementID& transferElementId) {
+      property->updateDoocsBuffer(transferElementId);
+    }
+
+    /// Cache the DOOCS property and location, so getDfct() and getEqFct() do not need a dynamic_cast on each update.
+    /// Called when registering variables, since the dynamic_cast only works once the derived class is constructed.
+    void resolveDoocsProperty();
+    /// Copy the data from the accessor into the DOOCS buffer. Properties supporting lazy updates implement this and
+    /// call fillDoocsBufferOrDefer() from their updateDoocsBuffer().
+    virtual void fillDoocsBuffer() {}
+
+    /// Write an aggregated sample returned by the HistoryDecimator into the history, without changing the published
+    /// value. Property types supporting history decimation implement this. Must be called with the location lock held.
+    virtual void writeHistoryEntry([[maybe_unused]] const HistoryDecimator::Sample& sample) {}
+
+    /// Returns whether the property type supports lazy updates, see setLazy()
+    virtual bool supportsLazyUpdate() { return false; }
+
+    /// Returns whether the property type supports suppressing unchanged updates, see setSuppressUnchanged()
+    virtual bool supportsSuppressUnchanged() { return false; }
+
+    /// Returns true if unchanged updates are suppressed and neither the data nor the validity differ from the last
+    /// call with the same slot. Otherwise the data is remembered for the next comparison and false is returned.
+    /// Properties with several arrays use one slot per array.
+    template<typename UserType>
+    bool isUnchanged(const std::vector<UserType>& data, DataValidity validity, size_t slot = 0);
+
+    /// Call fillDoocsBuffer(), or only mark the DOOCS buffer as outdated if lazy updates are enabled
+    void fillDoocsBufferOrDefer();
+
+    /// update for data consistency group. Also enforces the rate limit, if configured.
     bool updateConsistency(const TransferElementID& updatedId);
+    /// the data consistency part of updateConsistency(), which does not access the DOOCS property
+    bool evaluateConsistency(const TransferElementID& updatedId);
+    /// check whether the update may be published with respect to the rate limit, called by updateConsistency()
+    bool checkRateLimit(const TransferElementID& updatedId);
     /// default implementation returns timestamp of _outputVarForVersionNum
     virtual doocs::Timestamp getTimestamp();
     /// implements timestamp workarounds for associated DOOCS property
@@ -92,10 +235,13 @@ namespace ChimeraTK {
     /// send data via ZeroMQ if enabled and if DOOCS initialisation is complete
     void sendZMQ(doocs::Timestamp timestamp);
 
-    /// make sure other properties using these PVs see the update
+    /// make sure other properties using these PVs see the update. With UpdaterConfig::asyncPropagation, updates from
+    /// RPC calls (handleLocking set) are only queued in the DoocsUpdater, which calls propagateChange() later.
     void updateOthers(bool handleLocking);
 
-    /// a helper which unifies data->device for DOOCS_T = one of D_array<DOOCS_PRIMITIVE_T> or D_spectrum
+    /// a helper which unifies data->device for DOOCS_T = one of D_array<DOOCS_PRIMITIVE_T> or D_spectrum. Unbuffered
+    /// spectra are copied in one go. D_array data is copied element by element, since D_array does not give access to
+    /// its storage.
     template<typename SELF, typename UserType>
     void sendArrayToDevice(SELF* dfct, OneDRegisterAccessor<UserType>& processArray);
 
@@ -108,18 +254,58 @@ namespace ChimeraTK {
 
     std::string _doocsPropertyName;
     DoocsUpdater& _doocsUpdater; // store the reference to the updater. We need it when adding the macro pulse number
+    // cached by resolveDoocsProperty()
+    D_fct* _dfct{nullptr};
+    EqFct* _eqFct{nullptr};
     bool _publishZMQ{false};
     // We keep a pointer to the main output var in order to access meta info like VersionNumbers.
     // Storing a plain pointer is ok here (even though the target is essentially a shared_ptr), since the pointer
     // target is owned by the same object (derived class).
     TransferElementAbstractor* _outputVarForVersionNum{nullptr};
+    bool _lazy{false};
+    bool _suppressUnchanged{false};
+    UpdatePriority _priority{UpdatePriority::normal};
+    // last published data for isUnchanged(), protected by the location lock
+    struct PublishedData {
+      std::vector<unsigned char> bytes;
+      std::optional<DataValidity> validity;
+    };
+    std::vector<PublishedData> _lastPublishedData;
+    // protected by the location lock
+    DeadbandFilter _deadband;
+    HistoryDecimator _historyDecimator;
+    bool _lazyUpdatePending{false}; // protected by the location lock
+    // set by precheckConsistency(), only accessed by the DoocsUpdater thread owning the location
+    bool _consistencyPrechecked{false};
     bool _doocsSuccessfullyUpdated{true}; // to detect data losses
     // counter used to reduce amount of data loss warnings printed at console
-    size_t _nDataLossWarnings{0};
+    std::atomic<size_t> _nDataLossWarnings{0};
+    // matches found in the history, see getNumberOfHistorizedMatches()
+    std::atomic<size_t> _nHistorizedMatches{0};
+
+    // rate limit, see setMaxRate(). All these are protected by the location lock, except _conflationPending which is
+    // also read by the DoocsUpdater without holding the lock.
+    std::chrono::steady_clock::duration _minUpdateInterval{0};
+    std::chrono::steady_clock::time_point _lastPublication;
+    RateLimitClock _now{&std::chrono::steady_clock::now};
+    std::atomic<bool> _conflationPending{false};
+    std::atomic<size_t> _nConflatedUpdates{0};
+
+    // set while the property is queued for propagateChange(), so repeated changes are queued only once
+    std::atomic<bool> _propagationPending{false};
   };
 
   /********************************************************************************************************************/
 
+  inline void PropertyBase::resolveDoocsProperty() {
+    if(!_dfct) {
+      _dfct = dynamic_cast<D_fct*>(this);
+      _eqFct = _dfct->get_eqfct();
+    }
+  }
+
+  /********************************************************************************************************************/
+
   inline void PropertyBase::setupOutputVar(TransferElementAbstractor& processVar) {
     registerVariable(processVar);
     _outputVarForVersionNum = &processVar;
@@ -132,6 +318,29 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  template<typename UserType>
+  bool PropertyBase::isUnchanged(const std::vector<UserType>& data, DataValidity validity, size_t slot) {
+    static_assert(std::is_trivially_copyable_v<UserType>);
+    if(!_suppressUnchanged) {
+      return false;
+    }
+    if(_lastPublishedData.size() <= slot) {
+      _lastPublishedData.resize(slot + 1);
+    }
+    auto& last = _lastPublishedData[slot];
+    size_t nBytes = data.size() * sizeof(UserType);
+    if(last.validity == validity && last.bytes.size() == nBytes &&
+        std::memcmp(last.bytes.data(), data.data(), nBytes) == 0) {
+      return true;
+    }
+    last.bytes.resize(nBytes);
+    std::memcpy(last.bytes.data(), data.data(), nBytes);
+    last.validity = validity;
+    return false;
+  }
+
+  /********************************************************************************************************************/
+
   template<typename SELF, typename UserType>
   void PropertyBase::sendArrayToDevice(SELF* dfct, OneDRegisterAccessor<UserType>& processArray) {
     constexpr bool isSpectrum = std::is_base_of<D_spectrum, SELF>::value;
@@ -146,14 +355,20 @@ namespace ChimeraTK {
       arraySize = std::min(arraySize, size_t(doocsLen));
     }
     if constexpr(isSpectrum) {
-      // FIXME: find the efficient, memcopying function for float
-      // always get a fresh reference
-      for(size_t i = 0; i < arraySize; ++i) {
-        processVector[i] = dfct->read_spectrum((int)i);
+      static_assert(std::is_same_v<UserType, float>);
+      const float* spectrumData = dfct->getSpectrumData();
+      if(spectrumData) {
+        std::memcpy(processVector, spectrumData, arraySize * sizeof(float));
+      }
+      else {
+        for(size_t i = 0; i < arraySize; ++i) {
+          processVector[i] = dfct->read_spectrum((int)i);
+        }
       }
     }
     else {
-      // Brute force implementation with a loop. Works for all data types.
+      // D_array only offers access to single elements, so there is no bulk copy or vectorised conversion like for
+      // unbuffered spectra or in the ConvertingDecorator. The reverse direction uses fill_array().
       for(size_t i = 0; i < arraySize; ++i) {
         processVector[i] = dfct->value(i);
       }
@@ -171,8 +386,13 @@ namespace ChimeraTK {
       else {
         dfct->set_length(arraySize);
         // restore value from ProcessArray, as it may have been destroyed in set_length().
-        for(size_t i = 0; i < arraySize; ++i) {
-          dfct->set_value(processVector[i], i);
+        if constexpr(std::is_same_v<typename SELF::THE_DOOCS_TYPE, UserType>) {
+          dfct->fill_array(processVector, arraySize);
+        }
+        else {
+          for(size_t i = 0; i < arraySize; ++i) {
+            dfct->set_value(processVector[i], i);
+          }
         }
       }
     }
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 #pragma once
 
+#include "HistoryDecimator.h"
+#include "UpdaterConfig.h"
 #include "Utilities.h"
 
 #include <ChimeraTK/DataConsistencyGroup.h>
@@ -58,6 +60,22 @@ namespace ChimeraTK {
     std::string isWriteableSource;
     DataConsistencyGroup::MatchingMode dataMatching;
     PersistConfig persist = PersistConfig::ON;
+    // maximum rate in Hz at which updates from the application are published, 0 means unlimited
+    double maxRate{0.};
+    // fill the DOOCS buffer only on demand, see PropertyBase::setLazy()
+    bool lazy{false};
+    // skip updates which do not change the data, see PropertyBase::setSuppressUnchanged()
+    bool suppressUnchanged{false};
+    // deadbands for publishing scalar updates, see PropertyBase::setDeadband(). 0 means no deadband.
+    double deadbandAbsolute{0.};
+    double deadbandRelative{0.};
+    // maximum rate in Hz of history entries and how samples are aggregated, see PropertyBase::setHistoryDecimation()
+    double historyMaxRate{0.};
+    HistoryAggregation historyAggregation{HistoryAggregation::mean};
+    // queue settings for the process variables of the property, see QueueConfig
+    QueueConfig queue;
+    // priority class of the updates of the property in the DoocsUpdater
+    UpdatePriority priority{UpdatePriority::normal};
     explicit PropertyAttributes(bool hasHistory_ = true, bool isWriteable_ = true, bool publishZMQ_ = false,
         std::string macroPulseNumberSource_ = "", std::string isWriteableSource_ = "",
         DataConsistencyGroup::MatchingMode dataMatching_ = DataConsistencyGroup::MatchingMode::exact)
@@ -67,7 +85,11 @@ namespace ChimeraTK {
     bool operator==(PropertyAttributes const& other) const {
       return (hasHistory == other.hasHistory && isWriteable == other.isWriteable && publishZMQ == other.publishZMQ &&
           macroPulseNumberSource == other.macroPulseNumberSource && dataMatching == other.dataMatching &&
-          persist == other.persist);
+          persist == other.persist && maxRate == other.maxRate && lazy == other.lazy &&
+          suppressUnchanged == other.suppressUnchanged && deadbandAbsolute == other.deadbandAbsolute &&
+          deadbandRelative == other.deadbandRelative && historyMaxRate == other.historyMaxRate &&
+          historyAggregation == other.historyAggregation && queue == other.queue &&
+          priority == other.priority);
     }
   };
 
@@ -312,6 +334,15 @@ namespace ChimeraTK {
     bool useHasHistoryDefault;
     bool useIsWriteableDefault;
     bool usePersistDefault = false;
+    bool useMaxRateDefault = false;
+    bool useLazyDefault = false;
+    bool useSuppressUnchangedDefault = false;
+    bool useDeadbandAbsoluteDefault = false;
+    bool useDeadbandRelativeDefault = false;
+    bool useHistoryMaxRateDefault = false;
+    bool useHistoryAggregationDefault = false;
+    bool useQueueDefault = false;
+    bool usePriorityDefault = false;
     bool useMacroPulseNumberSourceDefault;
     bool useDataMatchingDefault;
     explicit LocationInfo(bool useHasHistoryDefault_ = false, bool useIsWriteableDefault_ = false,
@@ -328,6 +359,7 @@ namespace ChimeraTK {
     ChimeraTK::RegisterPath statusCodeSource;
     ChimeraTK::RegisterPath statusStringSource;
     std::string targetLocation;
+    UpdatePriority priority{UpdatePriority::normal};
   };
 
   /********************************************************************************************************************/
@@ -24,8 +24,9 @@ namespace ChimeraTK {
     using NDRegisterAccessorDecorator<UserType, UserType>::_target;
     [[nodiscard]] bool isFan() const { return _isFan; }
     /// this exchanges the target by a newly created process variable; also the readQueue is exchanged.
-    void setupFan();
-    void addToFan(RoutingDecorator& fan);
+    /// numberOfBuffers is passed on to createSynchronizedProcessArray() and determines the length of the new queue.
+    void setupFan(size_t numberOfBuffers = 3);
+    void addToFan(RoutingDecorator& fan, size_t numberOfBuffers = 3);
     auto& getSource() { return _source; }
     auto& getCopies() { return _copies; }
 
@@ -48,8 +49,9 @@ namespace ChimeraTK {
 
   class RoutingDecoratorDomain {
    public:
-    /// return a new RoutingDecorator for source; creates the fan-out on first call for given source.
-    TransferElement::SharedPtr add(TransferElement::SharedPtr source);
+    /// return a new RoutingDecorator for source; creates the fan-out on first call for given source. The copy for the
+    /// new RoutingDecorator uses the given number of buffers, see createSynchronizedProcessArray().
+    TransferElement::SharedPtr add(TransferElement::SharedPtr source, size_t numberOfBuffers = 3);
     /// For updatedElement = source of a fan-out belonging to RoutingDecoratorDomain, send out the copies and return
     /// true. If updatedElement is not source of a known fan-out do nothing and return false.
     bool send(TransferElementID updatedElement);
@@ -74,7 +76,7 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   template<typename UserType>
-  void RoutingDecorator<UserType>::setupFan() {
+  void RoutingDecorator<UserType>::setupFan(size_t numberOfBuffers) {
     assert(!_isFan);
     // assert that we do decoration with DataConsistencyDecorator only after setupFan.
     // DataConsistencyDecorator implements a continuation of the readQueue, so the latter must not be
@@ -83,7 +85,7 @@ namespace ChimeraTK {
 
     std::size_t size = this->getNumberOfSamples();
     auto pvName = this->getName() + "_fanOut_0"; // set a name just for debugging purpose
-    auto [sender, receiver] = createSynchronizedProcessArray<UserType>(size, pvName);
+    auto [sender, receiver] = createSynchronizedProcessArray<UserType>(size, pvName, "", "", {}, numberOfBuffers);
     _source = _target;
     _copies.emplace_back(sender);
     // set receiver as our new target. this also exchanges our future_queue. But make sure to keep our id.
@@ -96,13 +98,13 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   template<typename UserType>
-  void RoutingDecorator<UserType>::addToFan(RoutingDecorator& fan) {
+  void RoutingDecorator<UserType>::addToFan(RoutingDecorator& fan, size_t numberOfBuffers) {
     assert(fan._isFan);
     std::size_t size = this->getNumberOfSamples();
     assert(fan.getNumberOfSamples() == size);
     // a name just for debugging purpose
     auto pvName = this->getName() + "_fanOut_" + std::to_string(fan._copies.size());
-    auto [sender, receiver] = createSynchronizedProcessArray<UserType>(size, pvName);
+    auto [sender, receiver] = createSynchronizedProcessArray<UserType>(size, pvName, "", "", {}, numberOfBuffers);
     fan._copies.emplace_back(sender);
     // set receiver as our new target. this also exchanges our future_queue. But make sure to keep our id.
     auto id = this->getId();
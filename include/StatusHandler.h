@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 #pragma once
 
+#include "UpdaterConfig.h"
+
 #include <ChimeraTK/ControlSystemAdapter/StatusWithMessageReader.h>
 
 #include <boost/noncopyable.hpp>
@@ -28,10 +30,12 @@ namespace ChimeraTK {
     void updateError(TransferElementID transferElementId);
 
     /// statusScalar and statusString are the variables to monitor. statusScalar is mandatory, statusString not.
-    /// If both are set, updates must come in consistently
+    /// If both are set, updates must come in consistently. The updates are handled with the given priority class by the
+    /// DoocsUpdater.
     StatusHandler(EqFct* eqFct, boost::shared_ptr<DoocsUpdater> updater,
         boost::shared_ptr<ChimeraTK::NDRegisterAccessor<int32_t>> const& statusScalar,
-        boost::shared_ptr<ChimeraTK::NDRegisterAccessor<std::string>> const& statusString = nullptr);
+        boost::shared_ptr<ChimeraTK::NDRegisterAccessor<std::string>> const& statusString = nullptr,
+        UpdatePriority priority = UpdatePriority::normal);
 
     /// mapping function from Device.status/StatusOutput to DOOCS error codes
     static int statusCodeMapping(int x);
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ChimeraTK {
+
+  /// Priority class of a variable in the DoocsUpdater. Pending updates of a higher class are processed first.
+  enum class UpdatePriority { low, normal, high };
+
+  /// Which updates of a process variable to deliver if the update thread falls behind
+  enum class QueuePolicy { all, latest };
+
+  /**
+   * Queue settings of a process variable, taken from the `queue` tag of the properties using it. With the policy
+   * `latest`, the update thread skips all but the newest of the pending updates. A depth above zero replaces the queue
+   * of the application's process variable by a queue of the given length owned by the adapter.
+   */
+  struct QueueConfig {
+    size_t depth{0};
+    QueuePolicy policy{QueuePolicy::all};
+    bool operator==(const QueueConfig& other) const = default;
+  };
+
+  /**
+   * Server-wide settings for the DoocsUpdater, taken from the `updater` tag in the root of the mapping XML file.
+   * The defaults reproduce the behaviour without any `updater` tag.
+   */
+  struct UpdaterConfig {
+    // Number of update threads. Locations which share process variables are always handled by the same thread.
+    size_t nThreads{1};
+
+    // Maximum number of notifications processed in one batch. With a value above 1, the updater collects all already
+    // pending notifications after waking up and takes each involved location lock only once for the whole batch.
+    size_t batchSize{1};
+
+    // Time limit for collecting a batch, counted from the first notification of the batch. Zero means no limit.
+    std::chrono::microseconds batchTimeBudget{0};
+
+    // If enabled, properties requesting the same type from a process variable with several consumers share one
+    // accessor. A single notification then calls the update functions of all these properties directly.
+    bool directDispatch{false};
+
+    // If enabled, changes written via RPC to process variables mapped to several properties are propagated to the other
+    // properties by a separate thread, instead of within the RPC call, see DoocsUpdater
+    bool asyncPropagation{false};
+
+    // Maximum number of consecutive updates of the same variable while updates of other variables are waiting, see
+    // DoocsUpdater. Zero means no limit.
+    size_t fairnessLimit{0};
+
+    // If enabled, the update threads do not wait for busy location locks. Updates for a busy location are parked and
+    // retried later, while the updates of other locations continue, see DoocsUpdater.
+    bool deferBusyLocations{false};
+
+    // CPUs to pin the update threads to, assigned round robin. Empty means no pinning.
+    std::vector<int> cpuAffinity;
+
+    // SCHED_FIFO priority (1 to 99) of the update threads. Zero means default scheduling.
+    int realtimePriority{0};
+
+    // Lock all current and future memory of the process into RAM (mlockall), to avoid page faults in the update threads
+    bool lockMemory{false};
+
+    // Time to poll for new notifications before blocking in ReadAnyGroup::waitAny(). Spinning avoids the wake-up
+    // latency of the blocking wait at the expense of CPU time. Zero means always blocking.
+    std::chrono::microseconds spinTime{0};
+
+    // Record the time from the creation of the version number of an update until its update functions are called, see
+    // DoocsUpdater::getLatencyStatistics()
+    bool measureLatency{false};
+
+    // Names of the locations whose updates are bundled into events, with the timeout for completing an event. Taken
+    // from the `event_builder` tag of the locations.
+    std::map<std::string, std::chrono::microseconds> eventBuilderTimeouts;
+  };
+
+} // namespace ChimeraTK
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "PropertyDescription.h"
+#include "UpdaterConfig.h"
 
 #include <ChimeraTK/RegisterPath.h>
 
@@ -51,6 +52,14 @@ namespace ChimeraTK {
     /// make a copy because we modify it inside.
     static bool evaluateBool(std::string txt);
 
+    /// Function to get a non-negative integer out of the text. Throws std::invalid_argument if the text is not a
+    /// valid non-negative integer.
+    static size_t evaluateUnsigned(const std::string& txt);
+
+    /// Function to get a non-negative floating point number out of the text. Throws std::invalid_argument if the text
+    /// is not a valid non-negative number.
+    static double evaluateNonNegative(const std::string& txt);
+
     /// Loop through the sub nodes and take the string from the first non-empty
     /// which can be casted to a string-node
     static std::string getContentString(xmlpp::Node const* node);
@@ -58,11 +67,24 @@ namespace ChimeraTK {
     /// Functiont o convert a string into a DataConsistencyGroup::MatchingMode enum value
     static DataConsistencyGroup::MatchingMode evaluateDataMatching(const std::string& txt);
 
+    /// Function to convert a string into a HistoryAggregation enum value
+    static HistoryAggregation evaluateHistoryAggregation(const std::string& txt);
+
+    /// Function to read the QueueConfig from the attributes of a `queue` node. Throws std::invalid_argument if the
+    /// depth is not a valid unsigned number or the policy is unknown.
+    static QueueConfig evaluateQueue(xmlpp::Node const* node);
+
+    /// Function to convert a string into an UpdatePriority enum value
+    static UpdatePriority evaluatePriority(const std::string& txt);
+
     /// Return all names of the process variables which have been mapped to the DOOCS control system.
     [[nodiscard]] const std::set<std::string>& getUsedVariables() const { return _userProcessVariables; }
 
     [[nodiscard]] const std::list<ErrorReportingInfo>& getErrorReportingInfos() const { return _errorReportingInfos; }
 
+    /// Settings for the DoocsUpdater from the `updater` tag
+    [[nodiscard]] const UpdaterConfig& getUpdaterConfig() const { return _updaterConfig; }
+
    protected:
     VariableMapper() = default;
 
@@ -73,6 +95,8 @@ namespace ChimeraTK {
 
     std::list<ErrorReportingInfo> _errorReportingInfos;
 
+    UpdaterConfig _updaterConfig;
+
     void processLocationNode(xmlpp::Node const* locationNode);
     void processNode(xmlpp::Node const* propertyNode, const std::string& locationName);
     void processSpectrumNode(xmlpp::Node const* node, const std::string& locationName);
@@ -83,6 +107,8 @@ namespace ChimeraTK {
     void processSetErrorNode(xmlpp::Node const* node, std::string& locationName);
     void processImportNode(xmlpp::Node const* importNode, const std::string& importLocationName = std::string());
     void processCode(xmlpp::Element const* location, const std::string& locationName);
+    void processUpdaterNode(xmlpp::Node const* updaterNode);
+    void processEventBuilderNode(xmlpp::Node const* node, const std::string& locationName);
 
     void import(std::string importSource, const std::string& importLocationName, const std::string& directory = "");
     bool getHasHistoryDefault(std::string const& locationName);
@@ -91,6 +117,15 @@ namespace ChimeraTK {
 
     std::string getMacroPulseNumberSourceDefault(std::string const& locationName);
     DataConsistencyGroup::MatchingMode getDataMatchingDefault(std::string const& locationName);
+    double getMaxRateDefault(std::string const& locationName);
+    bool getLazyDefault(std::string const& locationName);
+    bool getSuppressUnchangedDefault(std::string const& locationName);
+    double getDeadbandAbsoluteDefault(std::string const& locationName);
+    double getDeadbandRelativeDefault(std::string const& locationName);
+    double getHistoryMaxRateDefault(std::string const& locationName);
+    HistoryAggregation getHistoryAggregationDefault(std::string const& locationName);
+    QueueConfig getQueueDefault(std::string const& locationName);
+    UpdatePriority getPriorityDefault(std::string const& locationName);
 
     std::map<std::string, LocationInfo> _locationDefaults;
     PropertyAttributes _globalDefaults;
@@ -48,7 +48,8 @@ namespace ChimeraTK {
       if(_controlSystemPVManager->hasProcessVariable(errorReportingInfo.statusStringSource)) {
         statusStringVariable = _updater->getMappedProcessVariable<std::string>(errorReportingInfo.statusStringSource);
       }
-      _statusHandler.reset(new StatusHandler(this, _updater, statusCodeVariable, statusStringVariable));
+      _statusHandler.reset(new StatusHandler(
+          this, _updater, statusCodeVariable, statusStringVariable, errorReportingInfo.priority));
     }
   }
 
@@ -88,6 +89,11 @@ namespace ChimeraTK {
      * if it should be persisted and it's not by default due to the restricting length MAX_CONF_LENGTH,
      * persist it in a separate file, but only if writable.
      */
+    // DOOCS persists the content of the DOOCS buffers, so fill those of lazy properties first. DOOCS calls write() with
+    // the location lock held.
+    for(auto* property : _lazyProperties) {
+      property->materialiseLazyUpdate();
+    }
     for(auto& pair : this->_doocsProperties) {
       // try a side-cast to get property attributes
       auto attrs = std::dynamic_pointer_cast<PropertyAttributes>(pair.first);
@@ -154,6 +160,9 @@ namespace ChimeraTK {
         auto prop = factory.create(propertyDescription);
         _doocsProperties[propertyDescription] = prop;
         auto p = boost::dynamic_pointer_cast<ChimeraTK::PropertyBase>(prop);
+        if(p->isLazy()) {
+          _lazyProperties.push_back(p.get());
+        }
 
         // if one of the PVs used by the property is among the keys of the writeableVariablesWithMultipleProperties
         // map, register the property in that PV group so its updateDoocsBuffer is called when the PV changes.
@@ -7,8 +7,10 @@
 #include "DoocsUpdater.h"
 #include "getAllVariableNames.h"
 #include "PropertyDescription.h"
+#include "Utilities.h"
 #include "VariableMapper.h"
 
+#include <algorithm>
 #include <filesystem>
 
 namespace ChimeraTK {
@@ -159,6 +161,7 @@ namespace ChimeraTK {
       std::cerr << "WARNING: No XML file for the Doocs variable config found. Trying direct import." << std::endl;
       ChimeraTK::VariableMapper::getInstance().directImport(pvNames);
     }
+    doocsAdapter.updater->setConfig(ChimeraTK::VariableMapper::getInstance().getUpdaterConfig());
 
     // prepare list of unmapped read variables and pass it to the Application for optimisation
     for(const auto& p : ChimeraTK::VariableMapper::getInstance().getUsedVariables()) {
@@ -179,9 +182,24 @@ namespace ChimeraTK {
     std::map<std::string, std::set<std::shared_ptr<ChimeraTK::PropertyDescription>>> reverseMapping;
     std::map<std::string, std::shared_ptr<ChimeraTK::PropertyDescription>> multiWriteDetectionMap;
 
+    // Number of accessors required per PV. Properties in the same location share the accessor of their macro pulse
+    // number source unless they use historized data matching (see DoocsUpdater::getMacroPulseNumberSource()), so
+    // they count only once per location.
+    std::map<std::string, size_t> numberOfAccessors;
+    std::map<std::string, std::set<std::string>> sharedMacroPulseNumberLocations;
+
     for(const auto& descr : ChimeraTK::VariableMapper::getInstance().getAllProperties()) {
+      std::string sharedMacroPulseNumberSource;
+      if(!descr->macroPulseNumberSource.empty() &&
+          descr->dataMatching != ChimeraTK::DataConsistencyGroup::MatchingMode::historized) {
+        sharedMacroPulseNumberSource = getAbsoluteSource(descr->macroPulseNumberSource, descr->location);
+      }
       for(const auto& source : descr->getSources()) {
         reverseMapping[source].insert(descr);
+        if(source != sharedMacroPulseNumberSource ||
+            sharedMacroPulseNumberLocations[source].insert(descr->location).second) {
+          ++numberOfAccessors[source];
+        }
       }
       for(const auto& source : descr->getWriteSources()) {
         auto it = multiWriteDetectionMap.find(source);
@@ -220,19 +238,74 @@ namespace ChimeraTK {
       writeableVariablesWithMultipleProperties[p.first] = {};
     }
 
+    // The set_error sources are read by the StatusHandler of the location, which counts as one more accessor. A fan
+    // is only required if they are used elsewhere as well.
+    for(const auto& errInfo : ChimeraTK::VariableMapper::getInstance().getErrorReportingInfos()) {
+      ++numberOfAccessors[errInfo.statusCodeSource];
+      if(errInfo.statusStringSource.length() > 1) {
+        ++numberOfAccessors[errInfo.statusStringSource];
+      }
+    }
+
     std::set<std::string> fanNamesFromDoocsAdapter;
-    for(const auto& el : reverseMapping) {
-      if(el.second.size() > 1) {
-        fanNamesFromDoocsAdapter.insert(el.first);
+    for(const auto& [source, count] : numberOfAccessors) {
+      if(count > 1) {
+        fanNamesFromDoocsAdapter.insert(source);
       }
     }
-    // we simply request fans for set_error sources without knowledge whether actually required
-    for(const auto& errInfo : ChimeraTK::VariableMapper::getInstance().getErrorReportingInfos()) {
-      fanNamesFromDoocsAdapter.insert(errInfo.statusCodeSource);
-      if(errInfo.statusStringSource.length() > 1) {
-        fanNamesFromDoocsAdapter.insert(errInfo.statusStringSource);
+
+    // Merge the queue settings of all properties using a PV: the largest depth wins, and only the latest value is
+    // delivered only if all properties agree. A configured depth is provided by the copy of a fan-out, so such PVs
+    // get a fan even if they have only a single consumer.
+    std::map<std::string, ChimeraTK::QueueConfig> queueConfigs;
+    for(const auto& [source, descriptions] : reverseMapping) {
+      ChimeraTK::QueueConfig queue{0, ChimeraTK::QueuePolicy::latest};
+      for(const auto& descr : descriptions) {
+        queue.depth = std::max(queue.depth, descr->queue.depth);
+        if(descr->queue.policy == ChimeraTK::QueuePolicy::all) {
+          queue.policy = ChimeraTK::QueuePolicy::all;
+        }
+      }
+      if(queue == ChimeraTK::QueueConfig{}) {
+        continue;
+      }
+      // Writeable PVs are written by DOOCS, which always sends every value. This includes bi-directional PVs, which
+      // cannot be routed through the fan-out of the queue (see DoocsUpdater::getMappedProcessVariableUnTyped()).
+      if(getControlSystemPVManager()->getProcessVariable(source)->isWriteable()) {
+        std::cerr << "WARNING: Ignoring the queue settings of the writeable process variable '" << source << "'."
+                  << std::endl;
+        continue;
+      }
+      queueConfigs[source] = queue;
+      if(queue.depth > 0) {
+        fanNamesFromDoocsAdapter.insert(source);
       }
     }
+    updater->setQueueConfigs(std::move(queueConfigs));
+
+    // With direct dispatch, consumers of a fan source share the accessor instead of getting one copy each. This is not
+    // possible if any consumer uses historized data matching, since the DataConsistencyGroup decorates the accessor.
+    if(updater->getConfig().directDispatch) {
+      std::set<std::string> errorReportingSources;
+      for(const auto& errInfo : ChimeraTK::VariableMapper::getInstance().getErrorReportingInfos()) {
+        errorReportingSources.insert(errInfo.statusCodeSource);
+        errorReportingSources.insert(errInfo.statusStringSource);
+      }
+      std::set<std::string> directDispatchNames;
+      for(const auto& source : fanNamesFromDoocsAdapter) {
+        if(errorReportingSources.contains(source)) {
+          continue;
+        }
+        bool hasHistorizedConsumer = std::ranges::any_of(reverseMapping[source], [](const auto& descr) {
+          return descr->dataMatching == ChimeraTK::DataConsistencyGroup::MatchingMode::historized;
+        });
+        if(!hasHistorizedConsumer) {
+          directDispatchNames.insert(source);
+        }
+      }
+      updater->setPvNamesWithDirectDispatch(directDispatchNames);
+    }
+
     updater->setPvNamesWithFan(fanNamesFromDoocsAdapter);
   }
 
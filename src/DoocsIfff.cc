@@ -12,6 +12,7 @@
 
 #include <doocs/EventId.h>
 
+#include <cmath>
 #include <utility>
 
 namespace ChimeraTK {
@@ -77,6 +78,15 @@ namespace ChimeraTK {
       return;
     }
 
+    // the deadband only considers the validity of the whole tuple, like the error state of the property below
+    auto validity = (_i1Value.dataValidity() == DataValidity::ok && _f1Value.dataValidity() == DataValidity::ok &&
+                        _f2Value.dataValidity() == DataValidity::ok && _f3Value.dataValidity() == DataValidity::ok) ?
+        DataValidity::ok :
+        DataValidity::faulty;
+    if(_deadband.isInside({double(_i1Value), double(_f1Value), double(_f2Value), double(_f3Value)}, validity)) {
+      return;
+    }
+
     bool storeInHistory = true;
     auto archiverStatus = ArchiveStatus::sts_ok;
     if(_i1Value.dataValidity() != ChimeraTK::DataValidity::ok ||
@@ -102,12 +112,24 @@ namespace ChimeraTK {
     ifff.f3_data = _f3Value;
 
     doocs::Timestamp timestamp = correctDoocsTimestamp();
+    if(_historyDecimator.isActive() && storeInHistory) {
+      // Only the aggregated samples go into the history, see HistoryDecimator. writeHistoryEntry() leaves the
+      // published value unchanged, the new value is published below. Repeated invalid data is not added, like it is
+      // not stored in the history without decimation (see below).
+      auto sample = _historyDecimator.add(
+          {double(ifff.i1_data), double(ifff.f1_data), double(ifff.f2_data), double(ifff.f3_data)},
+          archiverStatus != ArchiveStatus::sts_ok, timestamp.to_time_point(),
+          _macroPulseNumberSource.isInitialised() ? int64_t(_macroPulseNumberSource) : 0);
+      if(sample) {
+        writeHistoryEntry(*sample);
+      }
+    }
     if(_macroPulseNumberSource.isInitialised()) {
       this->set_mpnum(_macroPulseNumberSource);
     }
     // We should also checked if data should be stored (flag storeInHistory). Invalid data should NOT be stored except
     // first invalid data point. (https://github.com/ChimeraTK/ControlSystemAdapter-DoocsAdapter/issues/40)
-    if(this->get_histPointer() && storeInHistory) {
+    if(this->get_histPointer() && storeInHistory && !_historyDecimator.isActive()) {
       /*FIXME: This set_and_archive does not support the timestamp yet (only sec and msec, and I guess m is milli?)*/
       /*FIXME: This set_and_archive does not support eventIDs yet */
       this->set_and_archive(&ifff, archiverStatus, 0, 0 /*msec*/);
@@ -127,6 +149,31 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void DoocsIfff::writeHistoryEntry(const HistoryDecimator::Sample& sample) {
+    if(!this->get_histPointer()) {
+      return;
+    }
+    IFFF entry;
+    entry.i1_data = int(std::lround(sample.values[0]));
+    entry.f1_data = float(sample.values[1]);
+    entry.f2_data = float(sample.values[2]);
+    entry.f3_data = float(sample.values[3]);
+
+    // set_and_archive() also sets the value, hence the published value is restored afterwards. Clients cannot see the
+    // aggregated value, since both happen while holding the location lock. The published value is always the last
+    // added sample, see HistoryDecimator.
+    IFFF published = *value();
+    auto publishedTimestamp = this->get_timestamp();
+    if(_macroPulseNumberSource.isInitialised()) {
+      this->set_mpnum(sample.eventId);
+    }
+    this->set_and_archive(&entry, sample.isFaulty ? ArchiveStatus::sts_err : ArchiveStatus::sts_ok, 0, 0 /*msec*/);
+    this->set_value(&published);
+    this->set_timestamp(publishedTimestamp);
+  }
+
+  /********************************************************************************************************************/
+
   void DoocsIfff::set(EqAdr* eqAdr, doocs::EqData* data1, doocs::EqData* data2, EqFct* eqFct) {
     D_ifff::set(eqAdr, data1, data2, eqFct); // inherited functionality fill the local doocs buffer
     if(_macroPulseNumberSource.isInitialised()) {
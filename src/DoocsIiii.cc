@@ -12,6 +12,7 @@
 
 #include <doocs/EventId.h>
 
+#include <cmath>
 #include <functional>
 
 namespace ChimeraTK {
@@ -57,6 +58,11 @@ namespace ChimeraTK {
       return;
     }
 
+    if(_deadband.isInside({double(_iiiiValue[0]), double(_iiiiValue[1]), double(_iiiiValue[2]), double(_iiiiValue[3])},
+           _iiiiValue.dataValidity())) {
+      return;
+    }
+
     bool storeInHistory = true;
     auto archiverStatus = ArchiveStatus::sts_ok;
     if(_iiiiValue.dataValidity() != ChimeraTK::DataValidity::ok) {
@@ -79,12 +85,24 @@ namespace ChimeraTK {
     iiii.i4_data = _iiiiValue[3];
 
     doocs::Timestamp timestamp = correctDoocsTimestamp();
+    if(_historyDecimator.isActive() && storeInHistory) {
+      // Only the aggregated samples go into the history, see HistoryDecimator. writeHistoryEntry() leaves the
+      // published value unchanged, the new value is published below. Repeated invalid data is not added, like it is
+      // not stored in the history without decimation (see below).
+      auto sample = _historyDecimator.add(
+          {double(iiii.i1_data), double(iiii.i2_data), double(iiii.i3_data), double(iiii.i4_data)},
+          archiverStatus != ArchiveStatus::sts_ok, timestamp.to_time_point(),
+          _macroPulseNumberSource.isInitialised() ? int64_t(_macroPulseNumberSource) : 0);
+      if(sample) {
+        writeHistoryEntry(*sample);
+      }
+    }
     if(_macroPulseNumberSource.isInitialised()) {
       this->set_mpnum(_macroPulseNumberSource);
     }
     // We should also checked if data should be stored (flag storeInHistory). Invalid data should NOT be stored except
     // first invalid data point. (https://github.com/ChimeraTK/ControlSystemAdapter-DoocsAdapter/issues/40)
-    if(this->get_histPointer() && storeInHistory) {
+    if(this->get_histPointer() && storeInHistory && !_historyDecimator.isActive()) {
       /*FIXME: This set_and_archive does not support the timestamp yet (only sec and msec, and I guess m is milli?)*/
       /*FIXME: This set_and_archive does not support eventIDs yet */
       this->set_and_archive(&iiii, archiverStatus, 0, 0 /*msec*/);
@@ -104,6 +122,31 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void DoocsIiii::writeHistoryEntry(const HistoryDecimator::Sample& sample) {
+    if(!this->get_histPointer()) {
+      return;
+    }
+    IIII entry;
+    entry.i1_data = int(std::lround(sample.values[0]));
+    entry.i2_data = int(std::lround(sample.values[1]));
+    entry.i3_data = int(std::lround(sample.values[2]));
+    entry.i4_data = int(std::lround(sample.values[3]));
+
+    // set_and_archive() also sets the value, hence the published value is restored afterwards. Clients cannot see the
+    // aggregated value, since both happen while holding the location lock. The published value is always the last
+    // added sample, see HistoryDecimator.
+    IIII published = *value();
+    auto publishedTimestamp = this->get_timestamp();
+    if(_macroPulseNumberSource.isInitialised()) {
+      this->set_mpnum(sample.eventId);
+    }
+    this->set_and_archive(&entry, sample.isFaulty ? ArchiveStatus::sts_err : ArchiveStatus::sts_ok, 0, 0 /*msec*/);
+    this->set_value(&published);
+    this->set_timestamp(publishedTimestamp);
+  }
+
+  /********************************************************************************************************************/
+
   void DoocsIiii::set(EqAdr* eqAdr, doocs::EqData* data1, doocs::EqData* data2, EqFct* eqFct) {
     D_iiii::set(eqAdr, data1, data2, eqFct); // inherited functionality fill the local doocs buffer
     if(_macroPulseNumberSource.isInitialised()) {
@@ -86,15 +86,8 @@ namespace ChimeraTK {
       return;
     }
 
-    D_imagec* dfct = this;
     //  Note: we already own the location lock by specification of the DoocsUpdater
 
-    MappedDoocsImg img(_processArray, MappedDoocsImg::InitData::No);
-    auto* dataPtr = img.asDoocsImg(&imh);
-    if(!dataPtr) {
-      throw logic_error("data provided to DoocsImage._processArray was not recognized as image");
-    }
-
     if(_processArray.dataValidity() != ChimeraTK::DataValidity::ok) {
       this->d_error(stale_data);
     }
@@ -106,19 +99,36 @@ namespace ChimeraTK {
 
     if(_macroPulseNumberSource.isInitialised()) {
       this->set_mpnum(_macroPulseNumberSource);
-      imh.event = _macroPulseNumberSource;
+      _eventNumber = _macroPulseNumberSource;
+    }
+
+    fillDoocsBufferOrDefer();
+
+    sendZMQ(timestamp);
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsImage::fillDoocsBuffer() {
+    D_imagec* dfct = this;
+    auto ts = dfct->get_timestamp().get_seconds_and_microseconds_since_epoch();
+
+    MappedDoocsImg img(_processArray, MappedDoocsImg::InitData::No);
+    auto* dataPtr = img.asDoocsImg(&imh);
+    if(!dataPtr) {
+      throw logic_error("data provided to DoocsImage._processArray was not recognized as image");
+    }
+    if(_macroPulseNumberSource.isInitialised()) {
+      imh.event = _eventNumber;
     }
 
     // this copies header and data contents to DOOCS-internal buffer
     dfct->set_value(&imh, dataPtr);
 
-    auto ts = timestamp.get_seconds_and_microseconds_since_epoch();
     // this is needed in addition to usual dfct call, in order to set time in img meta data
     // note, some meta data is not correctly shown by DOOCS rpc interface but is in ZMQ.
     dfct->set_img_time(ts.seconds, ts.microseconds);
     // dfct->set_img_status();
-
-    sendZMQ(timestamp);
   }
 
   /********************************************************************************************************************/
@@ -408,19 +408,8 @@ namespace ChimeraTK {
       doocsPV->publishZeroMQ();
     }
 
-    // set macro pulse number source, if configured
+    doocsPV->setMacroPulseNumberSource(propertyDescription.macroPulseNumberSource);
     if(!propertyDescription.macroPulseNumberSource.empty()) {
-      auto mpnSource = _updater.getMappedProcessVariable<int64_t>(propertyDescription.macroPulseNumberSource);
-      if(mpnSource->getNumberOfSamples() != 1) {
-        throw ChimeraTK::logic_error("The property '" + mpnSource->getName() +
-            "' is used as a macro pulse number source, but it has an array length of " +
-            std::to_string(mpnSource->getNumberOfSamples()) + ". Length must be exactly 1");
-      }
-      if(!mpnSource->isReadable()) {
-        throw ChimeraTK::logic_error("The property '" + mpnSource->getName() +
-            "' is used as a macro pulse number source, but it is not readable.");
-      }
-      doocsPV->setMacroPulseNumberSource(mpnSource);
       doocsPV->setIsWriteableSource(propertyDescription.isWriteableSource);
     }
 
@@ -475,6 +464,27 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   boost::shared_ptr<D_fct> DoocsPVFactory::create(std::shared_ptr<PropertyDescription> const& propertyDescription) {
+    auto doocsPV = createByType(propertyDescription);
+
+    // apply settings which are common to all property types
+    auto property = boost::dynamic_pointer_cast<PropertyBase>(doocsPV);
+    assert(property);
+    property->setMaxRate(propertyDescription->maxRate);
+    property->setLazy(propertyDescription->lazy);
+    property->setSuppressUnchanged(propertyDescription->suppressUnchanged);
+    property->setDeadband(propertyDescription->deadbandAbsolute, propertyDescription->deadbandRelative);
+    if(propertyDescription->hasHistory) {
+      property->setHistoryDecimation(propertyDescription->historyMaxRate, propertyDescription->historyAggregation);
+    }
+    property->setPriority(propertyDescription->priority);
+
+    return doocsPV;
+  }
+
+  /********************************************************************************************************************/
+
+  boost::shared_ptr<D_fct> DoocsPVFactory::createByType(
+      std::shared_ptr<PropertyDescription> const& propertyDescription) {
     auto& plainDescription = *propertyDescription;
     const auto& requestedType = typeid(plainDescription);
     if(requestedType == typeid(AutoPropertyDescription)) {
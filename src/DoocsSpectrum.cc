@@ -10,6 +10,7 @@
 
 #include <eq_fct.h>
 
+#include <cassert>
 #include <iostream>
 #include <utility>
 
@@ -130,6 +131,10 @@ namespace ChimeraTK {
       return;
     }
 
+    if(isUnchanged(static_cast<const std::vector<float>&>(_processArray), _processArray.dataValidity())) {
+      return;
+    }
+
     doocs::Timestamp timestamp = correctDoocsTimestamp();
 
     auto sinceEpoch = timestamp.get_seconds_and_microseconds_since_epoch();
@@ -154,14 +159,11 @@ namespace ChimeraTK {
     }
 
     // fill the spectrum
-    const std::vector<float>& processVector = _processArray;
     if(_nBuffers == 1) {
-      // We have to fill the spectrum differently if it is unbuffered, as the internal data structures seem to be
-      // completely different.
-      memcpy(spectrum()->d_spect_array.d_spect_array_val, processVector.data(), processVector.size() * sizeof(float));
-      spectrum()->d_spect_array.d_spect_array_len = processVector.size();
+      fillDoocsBufferOrDefer();
     }
     else {
+      const std::vector<float>& processVector = _processArray;
       fill_spectrum(processVector.data(), processVector.size(), ibuf);
     }
 
@@ -173,6 +175,17 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void DoocsSpectrum::fillDoocsBuffer() {
+    assert(_nBuffers == 1);
+    // We have to fill the spectrum differently if it is unbuffered, as the internal data structures seem to be
+    // completely different.
+    const std::vector<float>& processVector = _processArray;
+    memcpy(spectrum()->d_spect_array.d_spect_array_val, processVector.data(), processVector.size() * sizeof(float));
+    spectrum()->d_spect_array.d_spect_array_len = processVector.size();
+  }
+
+  /********************************************************************************************************************/
+
   void DoocsSpectrum::updateParameters() {
     // Note: we already own the location lock by specification of the DoocsUpdater
     float start, increment;
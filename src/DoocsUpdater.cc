@@ -6,29 +6,125 @@
 #include <ChimeraTK/cppext/threadName.hpp>
 #include <ChimeraTK/ReadAnyGroup.h>
 
-#include <unordered_set>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <unordered_map>
 
 namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
-  void DoocsUpdater::addVariable(
-      const TransferElementAbstractor& variable, EqFct* eq_fct, const std::function<void()>& updaterFunction) {
+  void DoocsUpdater::addVariable(const TransferElementAbstractor& variable, EqFct* eq_fct,
+      const std::function<void()>& updaterFunction, PropertyBase* property) {
+    UpdateFunction function;
+    function.function = updaterFunction;
+    addVariable(variable, eq_fct, std::move(function), bool(updaterFunction), property);
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::addVariable(const TransferElementAbstractor& variable, EqFct* eq_fct,
+      PropertyBase::UpdateThunk updateThunk, PropertyBase* property) {
+    assert(updateThunk && property);
+    UpdateFunction function;
+    function.thunk = updateThunk;
+    function.property = property;
+    function.id = variable.getId();
+    addVariable(variable, eq_fct, std::move(function), true, property);
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::addVariable(const TransferElementAbstractor& variable, EqFct* eq_fct, UpdateFunction&& function,
+      bool hasFunction, PropertyBase* property) {
     // Don't add the transfer element twice into the list of elements to read (not allowed with ReadAnyGroup).
     if(_toDoocsDescriptorMap.find(variable.getId()) == _toDoocsDescriptorMap.end()) {
       _elementsToRead.push_back(variable);
     }
 
-    if(updaterFunction) {
-      _toDoocsDescriptorMap[variable.getId()].updateFunctions.push_back(updaterFunction);
+    // Always create the descriptor, so the update threads can access it without modifying the map.
+    auto& descriptor = _toDoocsDescriptorMap[variable.getId()];
+    if(hasFunction) {
+      descriptor.updateFunctions.push_back(std::move(function));
+      descriptor.properties.push_back(property);
+    }
+    if(!property) {
+      descriptor.allPropertiesKnown = false;
     }
     if(eq_fct) {
-      _toDoocsDescriptorMap[variable.getId()].locations.push_back(eq_fct);
+      descriptor.locations.push_back(eq_fct);
     }
   }
 
   /********************************************************************************************************************/
 
+  void DoocsUpdater::setPriority(const TransferElementID& id, UpdatePriority priority) {
+    auto& descriptor = _toDoocsDescriptorMap[id];
+    descriptor.priority = std::max(descriptor.priority, priority);
+  }
+
+  /********************************************************************************************************************/
+
+  DoocsUpdater::WaitTimeStatistics DoocsUpdater::getWaitTimeStatistics(UpdatePriority priority) const {
+    return getStatistics(_waitTimes[static_cast<size_t>(priority)]);
+  }
+
+  /********************************************************************************************************************/
+
+  DoocsUpdater::WaitTimeStatistics DoocsUpdater::getParkedTimeStatistics(EqFct* location) const {
+    auto it = _parkedTimes.find(location);
+    if(it == _parkedTimes.end()) {
+      return {};
+    }
+    return getStatistics(it->second);
+  }
+
+  /********************************************************************************************************************/
+
+  DoocsUpdater::WaitTimeStatistics DoocsUpdater::getStatistics(const WaitTimeCounters& counters) {
+    WaitTimeStatistics statistics;
+    statistics.nUpdates = counters.nUpdates;
+    statistics.total = std::chrono::microseconds(counters.totalMicroseconds);
+    statistics.max = std::chrono::microseconds(counters.maxMicroseconds);
+    return statistics;
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::recordWaitTime(WaitTimeCounters& counters, std::chrono::nanoseconds waitTime) {
+    auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(waitTime).count();
+    ++counters.nUpdates;
+    counters.totalMicroseconds += microseconds;
+    auto max = counters.maxMicroseconds.load();
+    while(microseconds > max && !counters.maxMicroseconds.compare_exchange_weak(max, microseconds)) {
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::addRateLimitedProperty(PropertyBase* property) {
+    _rateLimitedProperties.push_back(property);
+    _minFlushInterval = std::min(_minFlushInterval, property->getMinUpdateInterval());
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::addDecimatedProperty(PropertyBase* property) {
+    _decimatedProperties.push_back(property);
+    _minFlushInterval = std::min(_minFlushInterval,
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(property->getHistoryInterval()));
+  }
+
+  /********************************************************************************************************************/
+
   void DoocsUpdater::update() {
     for(auto& transferElem : _elementsToRead) {
       if(transferElem.readLatest()) {
@@ -42,82 +138,303 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   void DoocsUpdater::updateLoop() {
-    if(_elementsToRead.empty()) {
-      return;
+    UpdatePartition partition;
+    partition.elementsToRead = _elementsToRead;
+    buildDispatchTable(partition);
+    updateLoop(partition);
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::buildDispatchTable(UpdatePartition& partition) {
+    partition.dispatchTable.clear();
+    partition.eventBuilders.clear();
+    partition.hasCollapsingEntries = false;
+    partition.isScheduled = _config.fairnessLimit > 0;
+    std::map<EqFct*, size_t> eventBuilderIndices;
+    for(auto& elem : partition.elementsToRead) {
+      // The ReadAnyGroup only assigns an index to elements with wait_for_new_data
+      if(!elem.getAccessModeFlags().has(AccessMode::wait_for_new_data)) {
+        continue;
+      }
+      auto& descriptor = _toDoocsDescriptorMap.at(elem.getId());
+      DispatchEntry entry;
+      entry.id = elem.getId();
+      entry.isFanSource = routing.isFanSource(entry.id);
+      entry.updateFunctions = descriptor.updateFunctions;
+      if(!entry.isFanSource) {
+        // The same location is registered once per property, so we have to remove the duplicates.
+        entry.locations = descriptor.locations;
+        std::sort(entry.locations.begin(), entry.locations.end());
+        entry.locations.erase(std::unique(entry.locations.begin(), entry.locations.end()), entry.locations.end());
+      }
+
+      // Events are only built for updates of a single location. Variables shared with other locations (e.g. with
+      // direct dispatch) are dispatched immediately.
+      if(entry.locations.size() == 1) {
+        auto timeout = _config.eventBuilderTimeouts.find(entry.locations.front()->name());
+        if(timeout != _config.eventBuilderTimeouts.end()) {
+          auto [it, isNew] = eventBuilderIndices.emplace(entry.locations.front(), partition.eventBuilders.size());
+          if(isNew) {
+            auto& builder = partition.eventBuilders.emplace_back();
+            builder.location = entry.locations.front();
+            builder.timeout = timeout->second;
+          }
+          entry.eventBuilder = it->second;
+          ++partition.eventBuilders[it->second].nEntries;
+        }
+      }
+
+      // Fan sources only distribute the data to the copies, which are scheduled on their own. They must not hold back
+      // high-priority copies, hence they always have the highest priority.
+      entry.priority = descriptor.priority;
+      if(entry.isFanSource) {
+        entry.priority = UpdatePriority::high;
+      }
+      for(auto* property : descriptor.properties) {
+        if(property) {
+          entry.priority = std::max(entry.priority, property->getPriority());
+        }
+      }
+      partition.isScheduled |= !entry.isFanSource && entry.priority != UpdatePriority::normal;
+
+      // Events collect each notification separately, so the backlog is collapsed only for entries without event
+      // builder
+      entry.collapseBacklog =
+          entry.eventBuilder == DispatchEntry::noEventBuilder && _latestPolicyIds.contains(entry.id);
+      partition.hasCollapsingEntries |= entry.collapseBacklog;
+
+      // The consistency can be evaluated before locking only if no other thread may access the accessor
+      entry.canPrecheck = !entry.isFanSource && entry.eventBuilder == DispatchEntry::noEventBuilder &&
+          !entry.updateFunctions.empty() && descriptor.allPropertiesKnown && !elem.isWriteable() &&
+          std::all_of(descriptor.properties.begin(), descriptor.properties.end(),
+              [](PropertyBase* property) { return property->allowsConsistencyPrecheck(); });
+      if(entry.canPrecheck) {
+        entry.properties = descriptor.properties;
+        entry.readyFunctions.reserve(entry.updateFunctions.size());
+      }
+      partition.dispatchTable.push_back(std::move(entry));
+    }
+
+    // Poll a few times per shortest timeout, within sensible limits
+    auto minTimeout = std::chrono::microseconds::max();
+    for(auto& builder : partition.eventBuilders) {
+      builder.pending.reserve(builder.nEntries);
+      minTimeout = std::min(minTimeout, builder.timeout);
+    }
+    partition.eventPollInterval =
+        std::clamp(minTimeout / 10, std::chrono::microseconds(10), std::chrono::microseconds(1000));
+
+    if(partition.isScheduled) {
+      for(auto& pending : partition.pending) {
+        pending.reserve(partition.dispatchTable.size());
+      }
+      partition.kept.reserve(partition.dispatchTable.size());
+      partition.yielded.reserve(partition.dispatchTable.size());
+    }
+
+    partition.parked.clear();
+    if(_config.deferBusyLocations) {
+      for(auto& entry : partition.dispatchTable) {
+        for(auto* location : entry.locations) {
+          _parkedTimes.try_emplace(location);
+        }
+      }
+      partition.lockedLocations.reserve(_parkedTimes.size());
+      partition.parkedLocations.reserve(_parkedTimes.size());
+      partition.parked.reserve(_config.batchSize);
+      partition.keptParked.reserve(_config.batchSize);
     }
+  }
 
-    std::unordered_set<EqFct*> locationsToLock;
+  /********************************************************************************************************************/
 
-    // preallocate locationsToLock to avoid breaking "realtime" behaivour
-    size_t nMaxLocationsToLock = 0;
-    for(auto& pair : _toDoocsDescriptorMap) {
-      nMaxLocationsToLock = std::max(nMaxLocationsToLock, pair.second.locations.size());
+  void DoocsUpdater::updateLoop(UpdatePartition& partition) {
+    if(partition.elementsToRead.empty()) {
+      return;
     }
-    locationsToLock.reserve(nMaxLocationsToLock);
 
-    ReadAnyGroup group(_elementsToRead.begin(), _elementsToRead.end());
+    ReadAnyGroup group(partition.elementsToRead.begin(), partition.elementsToRead.end());
 
-    // Execute preRead() on all _elementsToRead while having the location lock. This prevents a data race for
+    // Execute preRead() on all elements while having the location lock. This prevents a data race for
     // bidirectional PVs, if a write operation happens concurrently (in the RPC thread). waitAny() will issue preRead()
     // again, but we cannot have the location lock during waitAny() any more, since it will block until the next change
     // arrives. The extra preRead does not hurt, since multiple consecutive preReads are ignored by the TransferElement
     // base class.
-    for(auto& pair : _toDoocsDescriptorMap) {
-      for(auto& location : pair.second.locations) {
-        if(locationsToLock.insert(location).second) {
-          location->lock();
-        }
-      }
+    std::vector<EqFct*> allLocations;
+    for(auto& entry : partition.dispatchTable) {
+      allLocations.insert(allLocations.end(), entry.locations.begin(), entry.locations.end());
     }
-    for(auto& elem : _elementsToRead) {
+    std::sort(allLocations.begin(), allLocations.end());
+    allLocations.erase(std::unique(allLocations.begin(), allLocations.end()), allLocations.end());
+    for(auto* location : allLocations) {
+      location->lock();
+    }
+    for(auto& elem : partition.elementsToRead) {
       elem.getHighLevelImplElement()->preRead(ChimeraTK::TransferType::read);
     }
-    for(const auto& location : locationsToLock) {
+    for(auto* location : allLocations) {
       location->unlock();
     }
-    locationsToLock.clear();
+
+    // Pre-allocate the containers for the batch to avoid breaking "realtime" behaviour
+    std::vector<ReadAnyGroup::Notification> batch;
+    batch.reserve(_config.batchSize);
+    std::vector<EqFct*> batchLocations;
+    batchLocations.reserve(allLocations.size());
+
+    std::vector<ReadAnyGroup::Notification> immediate;
+    if(!partition.eventBuilders.empty()) {
+      immediate.reserve(_config.batchSize);
+    }
 
     while(true) {
-      // Wait until any variable got an update
-      auto notification = group.waitAny();
-      auto updatedElement = notification.getId();
-      auto& descriptor = _toDoocsDescriptorMap[updatedElement];
-
-      bool isFanSource = routing.isFanSource(updatedElement);
-      if(!isFanSource) {
-        // Gather all involved locations in a unique set
-        for(auto& location : descriptor.locations) {
-          if(locationsToLock.insert(location).second) {
-            location->lock();
+      // Wait until any variable got an update. While events are incomplete, poll instead so their timeouts can be
+      // detected.
+      bool hasPendingEvents = std::any_of(partition.eventBuilders.begin(), partition.eventBuilders.end(),
+          [](const EventBuilder& builder) { return !builder.pending.empty(); });
+      if(partition.isScheduled && partition.nPending > 0) {
+        // Notifications are still waiting to be scheduled. New notifications are collected by schedule().
+      }
+      else if(hasPendingEvents || !partition.parked.empty()) {
+        auto notification = group.waitAnyNonBlocking();
+        if(!notification.isReady()) {
+          dispatchExpiredEvents(partition);
+          auto pollInterval = partition.eventPollInterval;
+          if(!partition.parked.empty()) {
+            // batch is empty, so only the parked notifications are retried
+            dispatchDeferred(partition, batch);
+            pollInterval = std::min(pollInterval, parkedRetryInterval);
           }
+          // sleep is an interruption point, which allows shutting down this thread
+          boost::this_thread::sleep_for(boost::chrono::microseconds(pollInterval.count()));
+          continue;
         }
+        batch.push_back(std::move(notification));
       }
-      // Complete the read transfer of the process variable.
-      if(notification.accept()) {
-        auto te = notification.getTransferElement();
-        assert(notification.getTransferElement().getVersionNumber() > VersionNumber{nullptr});
-        if(isFanSource) {
-          // if updated process var is source for a fan-out, generate the copies
-          // We assume that all elements (source and copies) are in our ReadAnyGroup
-          // Do not send out updates via DOOCS if the update is for source of a fan-out.
-          assert(descriptor.updateFunctions.empty());
-          routing.send(updatedElement);
+      else {
+        batch.push_back(waitAny(group));
+      }
+
+      if(partition.isScheduled) {
+        schedule(partition, group, batch);
+        if(batch.empty()) {
+          boost::this_thread::interruption_point();
+          continue;
         }
-        else {
-          // Call all updater functions
-          for(auto& updaterFunction : descriptor.updateFunctions) {
-            updaterFunction();
+      }
+      // In batch mode, collect all notifications which are already pending (within the limits)
+      else if(_config.batchSize > 1) {
+        auto deadline = std::chrono::steady_clock::now() + _config.batchTimeBudget;
+        while(batch.size() < _config.batchSize) {
+          if(_config.batchTimeBudget.count() > 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+          }
+          auto notification = group.waitAnyNonBlocking();
+          if(!notification.isReady()) {
+            break;
           }
+          batch.push_back(std::move(notification));
         }
-        // Run preRead() while we still have the location lock. See above comment for running preRead before the
-        // while(true) loop for an explanation.
-        te.getHighLevelImplElement()->preRead(ChimeraTK::TransferType::read);
+      }
+
+      // For entries with the queue policy "latest", collect all pending notifications regardless of the batch limits,
+      // so all but the newest notification of these entries can be skipped below.
+      if(partition.hasCollapsingEntries &&
+          std::any_of(batch.begin(), batch.end(), [&](const ReadAnyGroup::Notification& notification) {
+            return partition.dispatchTable[notification.getIndex()].collapseBacklog;
+          })) {
+        while(true) {
+          auto notification = group.waitAnyNonBlocking();
+          if(!notification.isReady()) {
+            break;
+          }
+          batch.push_back(std::move(notification));
+        }
+      }
+
+      // Hand over the notifications of locations with an event builder to their events
+      if(!partition.eventBuilders.empty()) {
+        for(auto& notification : batch) {
+          auto& entry = partition.dispatchTable[notification.getIndex()];
+          if(entry.eventBuilder == DispatchEntry::noEventBuilder) {
+            immediate.push_back(std::move(notification));
+          }
+          else {
+            addToEvent(partition, entry, std::move(notification));
+          }
+        }
+        batch.swap(immediate);
+        immediate.clear();
+        dispatchExpiredEvents(partition);
+        if(batch.empty()) {
+          boost::this_thread::interruption_point();
+          continue;
+        }
+      }
+
+      if(_config.deferBusyLocations) {
+        dispatchDeferred(partition, batch);
+        batch.clear();
+        boost::this_thread::interruption_point();
+        continue;
+      }
+
+      // A single notification is dispatched without taking the location locks, if no property has consistent data.
+      // Batches are not prechecked, since each notification has to be dispatched before the next one for the same
+      // accessor is accepted.
+      if(batch.size() == 1) {
+        auto& entry = partition.dispatchTable[batch.front().getIndex()];
+        if(entry.canPrecheck) {
+          dispatchPrechecked(entry, batch.front());
+          batch.clear();
+          boost::this_thread::interruption_point();
+          continue;
+        }
+      }
+
+      // Determine the locations to lock. For a single notification the entry has them unique and sorted already.
+      const std::vector<EqFct*>* locationsToLock = &partition.dispatchTable[batch.front().getIndex()].locations;
+      if(batch.size() > 1) {
+        batchLocations.clear();
+        for(auto& notification : batch) {
+          auto& locations = partition.dispatchTable[notification.getIndex()].locations;
+          batchLocations.insert(batchLocations.end(), locations.begin(), locations.end());
+        }
+        std::sort(batchLocations.begin(), batchLocations.end());
+        batchLocations.erase(std::unique(batchLocations.begin(), batchLocations.end()), batchLocations.end());
+        locationsToLock = &batchLocations;
+      }
+
+      // Lock all involved locations. The list is empty for fan-out sources.
+      for(auto* location : *locationsToLock) {
+        location->lock();
+      }
+      ++_nLockRounds;
+      _nBatchedNotifications += batch.size();
+      // Count the notifications of entries which only dispatch the newest one
+      if(partition.hasCollapsingEntries) {
+        for(auto& notification : batch) {
+          auto& entry = partition.dispatchTable[notification.getIndex()];
+          if(entry.collapseBacklog) {
+            ++entry.nInBatch;
+          }
+        }
+      }
+      // Process the notifications in the order of arrival
+      for(auto& notification : batch) {
+        auto& entry = partition.dispatchTable[notification.getIndex()];
+        if(entry.collapseBacklog && --entry.nInBatch > 0) {
+          skip(notification);
+          continue;
+        }
+        dispatch(entry, notification);
       }
       // Unlock all involved locations
-      for(const auto& location : locationsToLock) {
+      for(auto* location : *locationsToLock) {
         location->unlock();
       }
-      locationsToLock.clear();
+      batch.clear();
 
       // Allow shutting down this thread...
       boost::this_thread::interruption_point();
@@ -126,23 +443,519 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void DoocsUpdater::recordLatency(const VersionNumber& version) {
+    if(!_config.measureLatency) {
+      return;
+    }
+    // The version number may have been created by another host with a slightly different clock
+    auto latency =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - version.getTime());
+    recordWaitTime(_latency, std::max(latency, std::chrono::nanoseconds::zero()));
+  }
+
+  /********************************************************************************************************************/
+
+  ReadAnyGroup::Notification DoocsUpdater::waitAny(ReadAnyGroup& group) {
+    if(_config.spinTime.count() > 0) {
+      auto deadline = std::chrono::steady_clock::now() + _config.spinTime;
+      do {
+        auto notification = group.waitAnyNonBlocking();
+        if(notification.isReady()) {
+          return notification;
+        }
+        boost::this_thread::interruption_point();
+      } while(std::chrono::steady_clock::now() < deadline);
+    }
+    return group.waitAny();
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::configureUpdateThread(size_t threadIndex) {
+    if(!_config.cpuAffinity.empty()) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(_config.cpuAffinity[threadIndex % _config.cpuAffinity.size()], &cpus);
+      int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      if(result != 0) {
+        std::cerr << "WARNING: Could not set the CPU affinity of the DoocsUpdater thread: " << std::strerror(result)
+                  << std::endl;
+      }
+    }
+    if(_config.realtimePriority > 0) {
+      sched_param parameters{};
+      parameters.sched_priority = _config.realtimePriority;
+      int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+      if(result != 0) {
+        std::cerr << "WARNING: Could not set the real-time priority of the DoocsUpdater thread: "
+                  << std::strerror(result) << std::endl;
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::schedule(
+      UpdatePartition& partition, ReadAnyGroup& group, std::vector<ReadAnyGroup::Notification>& batch) {
+    auto now = std::chrono::steady_clock::now();
+    auto enqueue = [&](ReadAnyGroup::Notification&& notification) {
+      auto& entry = partition.dispatchTable[notification.getIndex()];
+      ++entry.nPending;
+      ++partition.nPending;
+      partition.pending[static_cast<size_t>(entry.priority)].push_back({std::move(notification), now});
+    };
+    for(auto& notification : batch) {
+      enqueue(std::move(notification));
+    }
+    batch.clear();
+    while(true) {
+      auto notification = group.waitAnyNonBlocking();
+      if(!notification.isReady()) {
+        break;
+      }
+      enqueue(std::move(notification));
+    }
+
+    // Select the notifications of this round, highest priority class first
+    for(size_t priority = nPriorities; priority-- > 0;) {
+      auto& pending = partition.pending[priority];
+      auto& counters = _waitTimes[priority];
+      partition.kept.clear();
+      for(auto& item : pending) {
+        auto& entry = partition.dispatchTable[item.notification.getIndex()];
+        bool othersWaiting = partition.nPending > entry.nPending;
+        if(batch.size() >= _config.batchSize || entry.hasYielded) {
+          partition.kept.push_back(std::move(item));
+          continue;
+        }
+        if(_config.fairnessLimit > 0 && entry.nConsecutive >= _config.fairnessLimit && othersWaiting) {
+          entry.hasYielded = true;
+          partition.yielded.push_back(item.notification.getIndex());
+          partition.kept.push_back(std::move(item));
+          continue;
+        }
+        entry.nConsecutive = othersWaiting ? entry.nConsecutive + 1 : 0;
+        --entry.nPending;
+        --partition.nPending;
+
+        recordWaitTime(counters, now - item.since);
+        batch.push_back(std::move(item.notification));
+      }
+      pending.swap(partition.kept);
+    }
+
+    // Variables which had to yield may be processed again in the next round
+    for(auto index : partition.yielded) {
+      auto& entry = partition.dispatchTable[index];
+      entry.hasYielded = false;
+      entry.nConsecutive = 0;
+    }
+    partition.yielded.clear();
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::dispatch(DispatchEntry& entry, ReadAnyGroup::Notification& notification) {
+    assert(entry.id == notification.getId());
+
+    // Complete the read transfer of the process variable.
+    if(!notification.accept()) {
+      return;
+    }
+    auto te = notification.getTransferElement();
+    assert(notification.getTransferElement().getVersionNumber() > VersionNumber{nullptr});
+    if(entry.isFanSource) {
+      // if updated process var is source for a fan-out, generate the copies
+      // We assume that all elements (source and copies) are in our ReadAnyGroup
+      // Do not send out updates via DOOCS if the update is for source of a fan-out.
+      assert(entry.updateFunctions.empty());
+      routing.send(entry.id);
+    }
+    else {
+      // Call all updater functions
+      for(auto& updaterFunction : entry.updateFunctions) {
+        updaterFunction();
+      }
+      recordLatency(te.getVersionNumber());
+    }
+    // Run preRead() while we still have the location lock. See comment for running preRead before the while(true)
+    // loop in updateLoop() for an explanation.
+    te.getHighLevelImplElement()->preRead(ChimeraTK::TransferType::read);
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::dispatchDeferred(UpdatePartition& partition, std::vector<ReadAnyGroup::Notification>& batch) {
+    auto& locked = partition.lockedLocations;
+    auto& blocked = partition.parkedLocations;
+    locked.clear();
+    blocked.clear();
+
+    // Returns a location of the entry which is used by a parked notification, nullptr if there is none
+    auto findBlocked = [&](const DispatchEntry& entry) -> EqFct* {
+      for(auto* location : entry.locations) {
+        if(std::find(blocked.begin(), blocked.end(), location) != blocked.end()) {
+          return location;
+        }
+      }
+      return nullptr;
+    };
+    auto block = [&](const DispatchEntry& entry) {
+      for(auto* location : entry.locations) {
+        if(std::find(blocked.begin(), blocked.end(), location) == blocked.end()) {
+          blocked.push_back(location);
+        }
+      }
+    };
+
+    // The parked notifications are older, so they are retried first in the order of arrival. Superseded notifications
+    // also need the location lock, since skip() completes the transfer of the accessor which the properties read from.
+    if(!partition.parked.empty()) {
+      auto now = std::chrono::steady_clock::now();
+      auto& kept = partition.keptParked;
+      kept.clear();
+      for(auto& item : partition.parked) {
+        auto& entry = partition.dispatchTable[item.notification.getIndex()];
+        if(findBlocked(entry) || tryLock(entry.locations, locked)) {
+          block(entry);
+          kept.push_back(std::move(item));
+          continue;
+        }
+        recordWaitTime(_parkedTimes.at(item.busyLocation), now - item.since);
+        if(item.isSuperseded) {
+          skip(item.notification);
+        }
+        else {
+          dispatch(entry, item.notification);
+        }
+      }
+      partition.parked.swap(kept);
+      kept.clear();
+    }
+
+    if(partition.hasCollapsingEntries) {
+      for(auto& notification : batch) {
+        auto& entry = partition.dispatchTable[notification.getIndex()];
+        if(entry.collapseBacklog) {
+          ++entry.nInBatch;
+        }
+      }
+    }
+
+    for(auto& notification : batch) {
+      auto& entry = partition.dispatchTable[notification.getIndex()];
+      bool isSuperseded = entry.collapseBacklog && --entry.nInBatch > 0;
+
+      // Keep the order of the updates within each location: behind a parked update, all further updates sharing one of
+      // its locations are parked
+      EqFct* busyLocation = findBlocked(entry);
+      if(!busyLocation) {
+        busyLocation = tryLock(entry.locations, locked);
+      }
+      if(busyLocation) {
+        if(entry.collapseBacklog) {
+          // older parked notifications of the same accessor are superseded by this one
+          for(auto& item : partition.parked) {
+            if(item.notification.getIndex() == notification.getIndex()) {
+              item.isSuperseded = true;
+            }
+          }
+        }
+        partition.parked.push_back(
+            {std::move(notification), std::chrono::steady_clock::now(), busyLocation, isSuperseded});
+        block(entry);
+        continue;
+      }
+
+      if(isSuperseded) {
+        skip(notification);
+      }
+      else {
+        dispatch(entry, notification);
+      }
+    }
+
+    for(auto* location : locked) {
+      location->unlock();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  EqFct* DoocsUpdater::tryLock(const std::vector<EqFct*>& locations, std::vector<EqFct*>& locked) {
+    for(auto* location : locations) {
+      if(std::find(locked.begin(), locked.end(), location) != locked.end()) {
+        continue;
+      }
+      if(!location->try_lock()) {
+        return location;
+      }
+      locked.push_back(location);
+    }
+    return nullptr;
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::skip(ReadAnyGroup::Notification& notification) {
+    // The value is overwritten by the next notification of the same accessor, just like with readLatest().
+    if(!notification.accept()) {
+      return;
+    }
+    ++_nSkippedUpdates;
+    notification.getTransferElement().getHighLevelImplElement()->preRead(ChimeraTK::TransferType::read);
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::dispatchPrechecked(DispatchEntry& entry, ReadAnyGroup::Notification& notification) {
+    assert(entry.id == notification.getId());
+    if(!notification.accept()) {
+      return;
+    }
+    auto te = notification.getTransferElement();
+
+    entry.readyFunctions.clear();
+    for(size_t i = 0; i < entry.properties.size(); ++i) {
+      if(entry.properties[i]->precheckConsistency(entry.id)) {
+        entry.readyFunctions.push_back(i);
+      }
+    }
+
+    if(entry.readyFunctions.empty()) {
+      // Nothing to publish. The accessor is not used by other threads, so no lock is required for the preRead().
+      te.getHighLevelImplElement()->preRead(ChimeraTK::TransferType::read);
+      return;
+    }
+
+    for(auto* location : entry.locations) {
+      location->lock();
+    }
+    for(auto i : entry.readyFunctions) {
+      entry.updateFunctions[i]();
+    }
+    recordLatency(te.getVersionNumber());
+    te.getHighLevelImplElement()->preRead(ChimeraTK::TransferType::read);
+    for(auto* location : entry.locations) {
+      location->unlock();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::addToEvent(
+      UpdatePartition& partition, DispatchEntry& entry, ReadAnyGroup::Notification&& notification) {
+    auto& builder = partition.eventBuilders[entry.eventBuilder];
+    // A second update of the same variable belongs to the next event, so the current one is as complete as it gets.
+    if(entry.isEventPending) {
+      dispatchEvent(partition, builder);
+    }
+    if(builder.pending.empty()) {
+      builder.deadline = std::chrono::steady_clock::now() + builder.timeout;
+    }
+    entry.isEventPending = true;
+    builder.pending.push_back(std::move(notification));
+    if(builder.pending.size() == builder.nEntries) {
+      dispatchEvent(partition, builder);
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::dispatchEvent(UpdatePartition& partition, EventBuilder& builder) {
+    builder.location->lock();
+    // Process the notifications in the order of arrival
+    for(auto& notification : builder.pending) {
+      auto& entry = partition.dispatchTable[notification.getIndex()];
+      entry.isEventPending = false;
+      dispatch(entry, notification);
+    }
+    builder.location->unlock();
+    builder.pending.clear();
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::dispatchExpiredEvents(UpdatePartition& partition) {
+    auto now = std::chrono::steady_clock::now();
+    for(auto& builder : partition.eventBuilders) {
+      if(!builder.pending.empty() && now >= builder.deadline) {
+        dispatchEvent(partition, builder);
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<std::list<TransferElementAbstractor>> DoocsUpdater::partitionElementsToRead(size_t nPartitions) {
+    nPartitions = std::max(nPartitions, size_t(1));
+
+    // Union-find over all locations: all locations used by the same element are merged into one component, since the
+    // update of that element requires the locks of all of them.
+    std::unordered_map<EqFct*, EqFct*> parent;
+    auto findRoot = [&](EqFct* location) {
+      while(parent[location] != location) {
+        parent[location] = parent[parent[location]];
+        location = parent[location];
+      }
+      return location;
+    };
+    for(const auto& elem : _elementsToRead) {
+      const auto& locations = _toDoocsDescriptorMap[elem.getId()].locations;
+      for(auto* location : locations) {
+        parent.emplace(location, location);
+      }
+      for(size_t i = 1; i < locations.size(); ++i) {
+        parent[findRoot(locations[i])] = findRoot(locations[0]);
+      }
+    }
+
+    // Collect the elements per component, keeping the order of _elementsToRead within each component
+    std::unordered_map<EqFct*, std::list<TransferElementAbstractor>> components;
+    std::list<TransferElementAbstractor> elementsWithoutLocation;
+    for(const auto& elem : _elementsToRead) {
+      const auto& locations = _toDoocsDescriptorMap[elem.getId()].locations;
+      if(locations.empty()) {
+        elementsWithoutLocation.push_back(elem);
+      }
+      else {
+        components[findRoot(locations[0])].push_back(elem);
+      }
+    }
+
+    // Distribute the components over the partitions, largest first, always into the currently smallest partition
+    std::vector<std::list<TransferElementAbstractor>*> sortedComponents;
+    sortedComponents.reserve(components.size());
+    for(auto& component : components) {
+      sortedComponents.push_back(&component.second);
+    }
+    std::stable_sort(sortedComponents.begin(), sortedComponents.end(),
+        [](const auto* a, const auto* b) { return a->size() > b->size(); });
+
+    std::vector<std::list<TransferElementAbstractor>> partitions(nPartitions);
+    auto smallestPartition = [&]() -> std::list<TransferElementAbstractor>& {
+      return *std::min_element(
+          partitions.begin(), partitions.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    };
+    for(auto* component : sortedComponents) {
+      auto& partition = smallestPartition();
+      partition.splice(partition.end(), *component);
+    }
+    for(auto& elem : elementsWithoutLocation) {
+      smallestPartition().push_back(elem);
+    }
+
+    partitions.erase(std::remove_if(partitions.begin(), partitions.end(), [](const auto& p) { return p.empty(); }),
+        partitions.end());
+    return partitions;
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::flushLoop() {
+    // Check a few times per shortest interval, so conflated updates and history entries are not delayed much beyond
+    // their interval. Limit the period to a sensible range, to neither burn CPU time nor delay too much.
+    auto period = std::clamp(std::chrono::duration_cast<std::chrono::microseconds>(_minFlushInterval / 4),
+        std::chrono::microseconds(1000), std::chrono::microseconds(100000));
+
+    while(true) {
+      // sleep is an interruption point, which allows shutting down this thread
+      boost::this_thread::sleep_for(boost::chrono::microseconds(period.count()));
+      for(auto* property : _rateLimitedProperties) {
+        property->flushConflatedUpdate();
+      }
+      for(auto* property : _decimatedProperties) {
+        property->flushHistory();
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::queuePropagation(boost::shared_ptr<PropertyBase> property) {
+    {
+      boost::lock_guard<boost::mutex> lock(_propagationMutex);
+      _propagationQueue.push_back(std::move(property));
+    }
+    _propagationQueueNotEmpty.notify_one();
+  }
+
+  /********************************************************************************************************************/
+
+  void DoocsUpdater::propagationLoop() {
+    // swapped with the queue, so both vectors keep their capacity
+    std::vector<boost::shared_ptr<PropertyBase>> batch;
+    while(true) {
+      {
+        boost::unique_lock<boost::mutex> lock(_propagationMutex);
+        // wait is an interruption point, which allows shutting down this thread
+        _propagationQueueNotEmpty.wait(lock, [this] { return !_propagationQueue.empty(); });
+        std::swap(batch, _propagationQueue);
+      }
+      for(auto& property : batch) {
+        property->propagateChange();
+      }
+      batch.clear();
+    }
+  }
+
+  /********************************************************************************************************************/
+
   void DoocsUpdater::run() {
-    _syncThread = boost::thread([this] {
-      cppext::setThreadName("DoocsUpdater");
-      updateLoop();
-    });
+    if(_config.lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      std::cerr << "WARNING: Could not lock the memory of the process: " << std::strerror(errno) << std::endl;
+    }
+
+    _partitions.clear();
+    for(auto& elementsToRead : partitionElementsToRead(_config.nThreads)) {
+      auto& partition = _partitions.emplace_back();
+      partition.elementsToRead = std::move(elementsToRead);
+      buildDispatchTable(partition);
+    }
+    for(size_t i = 0; i < _partitions.size(); ++i) {
+      _syncThreads.emplace_back([this, i] {
+        cppext::setThreadName(_partitions.size() > 1 ? "DoocsUpdater" + std::to_string(i) : "DoocsUpdater");
+        configureUpdateThread(i);
+        updateLoop(_partitions[i]);
+      });
+    }
+    if(!_rateLimitedProperties.empty() || !_decimatedProperties.empty()) {
+      _syncThreads.emplace_back([this] {
+        cppext::setThreadName("DoocsUpdFlush");
+        flushLoop();
+      });
+    }
+    if(_config.asyncPropagation) {
+      _propagationActive = true;
+      _syncThreads.emplace_back([this] {
+        cppext::setThreadName("DoocsUpdProp");
+        propagationLoop();
+      });
+    }
   }
 
   /********************************************************************************************************************/
 
   void DoocsUpdater::stop() {
-    if(_syncThread.joinable()) {
-      _syncThread.interrupt();
+    bool anyJoinable = std::any_of(_syncThreads.begin(), _syncThreads.end(), [](auto& t) { return t.joinable(); });
+    if(anyJoinable) {
+      for(auto& thread : _syncThreads) {
+        thread.interrupt();
+      }
       for(auto& var : _elementsToRead) {
         var.getHighLevelImplElement()->interrupt();
       }
-      _syncThread.join();
+      for(auto& thread : _syncThreads) {
+        if(thread.joinable()) {
+          thread.join();
+        }
+      }
     }
+    _syncThreads.clear();
+    // changes still queued are dropped, the properties are shutting down anyway
+    _propagationActive = false;
+    boost::lock_guard<boost::mutex> lock(_propagationMutex);
+    _propagationQueue.clear();
   }
 
   /********************************************************************************************************************/
@@ -163,20 +976,50 @@ namespace ChimeraTK {
     if(pv->isWriteable()) {
       return pv;
     }
+    QueueConfig queue;
+    auto queueConfig = _queueConfigs.find(pv->getName());
+    if(queueConfig != _queueConfigs.end()) {
+      queue = queueConfig->second;
+    }
+
+    TransferElement::SharedPtr ret = pv;
     bool sourceRequiresFan = _pvNamesWithFan.contains(pv->getName());
-    if(!sourceRequiresFan) {
-      return pv;
+    if(sourceRequiresFan) {
+      // We add the source for the fan to elementsToRead.
+      // We don't need a doocsUpdater function for the source.
+      TransferElementID sourceId = pv->getId();
+      if(!_toDoocsDescriptorMap.contains(sourceId)) {
+        _elementsToRead.emplace_back(pv);
+        _toDoocsDescriptorMap[sourceId];
+      }
+
+      // The queue of the copy holds depth updates, one more buffer is required for the receiving side. Without a
+      // configured depth the default of createSynchronizedProcessArray() is kept.
+      ret = routing.add(pv, queue.depth > 0 ? queue.depth + 1 : 3);
     }
 
-    // We add the source for the fan to elementsToRead.
-    // We don't need a doocsUpdater function for the source.
-    TransferElementID sourceId = pv->getId();
-    if(!_toDoocsDescriptorMap.contains(sourceId)) {
-      _elementsToRead.emplace_back(pv);
-      _toDoocsDescriptorMap[sourceId];
+    if(queue.policy == QueuePolicy::latest) {
+      // Decorators placed around the returned accessor keep its id
+      _latestPolicyIds.insert(ret->getId());
     }
+    return ret;
+  }
 
-    return routing.add(pv);
+  /********************************************************************************************************************/
+
+  boost::shared_ptr<NDRegisterAccessor<int64_t>> DoocsUpdater::getMacroPulseNumberSource(
+      const ChimeraTK::RegisterPath& sourcePath, EqFct* location, DataConsistencyGroup::MatchingMode matchingMode) {
+    if(matchingMode == DataConsistencyGroup::MatchingMode::historized) {
+      return getMappedProcessVariable<int64_t>(sourcePath);
+    }
+
+    // use the canonical PV name as key, so differently written paths map to the same accessor
+    auto name = _controlSystemPVManager->getProcessVariable(sourcePath)->getName();
+    auto& sharedSource = _sharedMacroPulseNumberSources[{name, location}];
+    if(!sharedSource) {
+      sharedSource = getMappedProcessVariable<int64_t>(sourcePath);
+    }
+    return sharedSource;
   }
 
   /********************************************************************************************************************/
@@ -28,6 +28,13 @@ namespace ChimeraTK {
       return;
     }
 
+    // evaluate both, so both are remembered for the next comparison
+    bool xUnchanged = isUnchanged(static_cast<const std::vector<float>&>(_xValues), _xValues.dataValidity(), 0);
+    bool yUnchanged = isUnchanged(static_cast<const std::vector<float>&>(_yValues), _yValues.dataValidity(), 1);
+    if(xUnchanged && yUnchanged) {
+      return;
+    }
+
     if(_xValues.dataValidity() != ChimeraTK::DataValidity::ok ||
         _yValues.dataValidity() != ChimeraTK::DataValidity::ok) {
       this->d_error(stale_data);
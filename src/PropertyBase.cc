@@ -6,6 +6,8 @@
 #include "DoocsAdapter.h"
 #include "DoocsUpdater.h"
 
+#include <algorithm>
+
 namespace ChimeraTK {
 
   /********************************************************************************************************************/
@@ -17,11 +19,11 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   void PropertyBase::registerVariable(TransferElementAbstractor& var, bool update) {
+    resolveDoocsProperty();
     if(var.isReadable()) {
-      auto id = var.getId();
       _consistencyGroup.add(var);
       if(update) {
-        _doocsUpdater.addVariable(var, getEqFct(), [this, id] { return updateDoocsBuffer(id); });
+        _doocsUpdater.addVariable(var, getEqFct(), _updateThunk, this);
       }
       else {
         _doocsUpdater.addVariable(var, getEqFct());
@@ -32,10 +34,36 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   bool PropertyBase::updateConsistency(const TransferElementID& updatedId) {
-    // FIXME: A first  implementation is checking the data consistency here. Later this should be
-    // before calling this function because calling this function through a function pointer is
-    // comparatively expensive.
+    if(_consistencyPrechecked) {
+      // The DoocsUpdater has already evaluated the consistency before taking the location lock and calling us, and
+      // found the data consistent. See precheckConsistency().
+      _consistencyPrechecked = false;
+      return checkRateLimit(updatedId);
+    }
+    if(!evaluateConsistency(updatedId)) {
+      return false;
+    }
+    return checkRateLimit(updatedId);
+  }
+
+  /********************************************************************************************************************/
+
+  bool PropertyBase::allowsConsistencyPrecheck() {
+    return _outputVarForVersionNum && !_outputVarForVersionNum->isWriteable() && !_isWriteableSource.isInitialised() &&
+        !_lazy && _minUpdateInterval.count() == 0 &&
+        _consistencyGroup.getMatchingMode() != DataConsistencyGroup::MatchingMode::historized;
+  }
+
+  /********************************************************************************************************************/
 
+  bool PropertyBase::precheckConsistency(const TransferElementID& updatedId) {
+    _consistencyPrechecked = evaluateConsistency(updatedId);
+    return _consistencyPrechecked;
+  }
+
+  /********************************************************************************************************************/
+
+  bool PropertyBase::evaluateConsistency(const TransferElementID& updatedId) {
     // Do not check if update is coming from another DOOCS property mapped to the same variable (ID invalid), since
     // the check would never pass. Such variables cannot use exact data matching anyway, since the update is triggered
     // from the DOOCS write to the other property.
@@ -47,6 +75,16 @@ namespace ChimeraTK {
     assert(_outputVarForVersionNum);
     TransferElementID compareTo = _outputVarForVersionNum->getId();
 
+    // With historized data matching, remember the newest version number in the group, so a match of an older version
+    // found in the history can be detected below
+    bool isHistorized = _consistencyGroup.getMatchingMode() == DataConsistencyGroup::MatchingMode::historized;
+    VersionNumber newestVersion{nullptr};
+    if(isHistorized) {
+      for(const auto& element : _consistencyGroup.getElements()) {
+        newestVersion = std::max(newestVersion, element.second.getVersionNumber());
+      }
+    }
+
     if(!_consistencyGroup.update(updatedId)) {
       // data is not consistent (yet). Don't update the Doocs buffer.
       // check if this will now throw away data and generate a warning
@@ -67,14 +105,43 @@ namespace ChimeraTK {
         // each variable separately.
         _doocsSuccessfullyUpdated = false;
       }
+      // A conflated update waiting for publication is now outdated, since the variables have moved on.
+      if(_conflationPending) {
+        _conflationPending = false;
+        ++_nConflatedUpdates;
+      }
       return false;
     }
+    if(isHistorized && _outputVarForVersionNum->getVersionNumber() < newestVersion) {
+      ++_nHistorizedMatches;
+    }
     _doocsSuccessfullyUpdated = true;
     return true;
   }
 
   /********************************************************************************************************************/
 
+  bool PropertyBase::checkRateLimit(const TransferElementID& updatedId) {
+    if(_minUpdateInterval.count() == 0) {
+      return true;
+    }
+    auto now = _now();
+    // Updates coming from other properties or from flushConflatedUpdate() (ID invalid) are always published.
+    if(updatedId.isValid() && now - _lastPublication < _minUpdateInterval) {
+      // Conflate: the value stays in the accessor and will be published by flushConflatedUpdate(), unless superseded
+      if(_conflationPending) {
+        ++_nConflatedUpdates;
+      }
+      _conflationPending = true;
+      return false;
+    }
+    _lastPublication = now;
+    _conflationPending = false;
+    return true;
+  }
+
+  /********************************************************************************************************************/
+
   doocs::Timestamp PropertyBase::getTimestamp() {
     assert(_outputVarForVersionNum);
     doocs::Timestamp timestamp(_outputVarForVersionNum->getVersionNumber().getTime());
@@ -128,13 +195,20 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   void PropertyBase::updateOthers(bool handleLocking) {
+    if(handleLocking && _doocsUpdater.isPropagationAsync()) {
+      // Leave the callbacks to the propagation thread, so the RPC call does not wait for the other locations
+      if(!callbacksOnChange().empty() && !_propagationPending.exchange(true)) {
+        _doocsUpdater.queuePropagation(shared_from_this());
+      }
+      return;
+    }
     // Release the location lock before calling callbacks to avoid deadlocks when callbacks lock other locations
     if(handleLocking) {
       getEqFct()->unlock();
     }
     // Invoke all registered callbacks, passing this property as the caller so callbacks can identify the source
-    for(const auto& callback : callbacksOnChange()) {
-      callback(handleLocking, shared_from_this());
+    for(const auto& listener : callbacksOnChange()) {
+      listener.callback(handleLocking, shared_from_this());
     }
     if(handleLocking) {
       getEqFct()->lock();
@@ -145,7 +219,8 @@ namespace ChimeraTK {
 
   void PropertyBase::setMacroPulseNumberSource(const std::string& sourcePath) {
     if(!sourcePath.empty()) {
-      auto mpnSource = _doocsUpdater.getMappedProcessVariable<int64_t>(sourcePath);
+      auto mpnSource =
+          _doocsUpdater.getMacroPulseNumberSource(sourcePath, getEqFct(), _consistencyGroup.getMatchingMode());
       if(mpnSource->getNumberOfSamples() != 1) {
         throw ChimeraTK::logic_error("The property '" + mpnSource->getName() +
             "' is used as a macro pulse number source, but it has an array length of " +
@@ -172,6 +247,16 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void PropertyBase::setPriority(UpdatePriority priority) {
+    _priority = priority;
+    // The update function of the is-writeable source is registered without the property, see setIsWriteableSource()
+    if(_isWriteableSource.isInitialised()) {
+      _doocsUpdater.setPriority(_isWriteableSource.getId(), priority);
+    }
+  }
+
+  /********************************************************************************************************************/
+
   void PropertyBase::setIsWriteableSource(const std::string& sourcePath) {
     if(!sourcePath.empty()) {
       auto isWriteableSource = _doocsUpdater.getMappedProcessVariable<ChimeraTK::Boolean>(sourcePath);
@@ -199,7 +284,7 @@ namespace ChimeraTK {
         // DOOCS property using the generic EqData interface.
         assert(!doocsAdapter.writeableVariablesWithMultiplePropertiesIsFinal);
         auto weakSelf = weak_from_this();
-        doocsAdapter.writeableVariablesWithMultipleProperties[sourcePath].emplace_back(
+        doocsAdapter.writeableVariablesWithMultipleProperties[sourcePath].push_back({getEqFct(),
             [weakSelf](bool handleLocking, const boost::shared_ptr<PropertyBase>& caller) {
               auto self = weakSelf.lock();
               if(!self) {
@@ -220,18 +305,96 @@ namespace ChimeraTK {
               if(handleLocking) {
                 self->getEqFct()->unlock();
               }
-            });
+            }});
       }
     }
   }
 
   /********************************************************************************************************************/
 
+  void PropertyBase::setMaxRate(double maxRate) {
+    if(maxRate <= 0.) {
+      return;
+    }
+    _minUpdateInterval =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1. / maxRate));
+    _doocsUpdater.addRateLimitedProperty(this);
+  }
+
+  /********************************************************************************************************************/
+
+  void PropertyBase::flushConflatedUpdate() {
+    // cheap check without the location lock first, since this is called periodically for all rate-limited properties
+    if(!_conflationPending) {
+      return;
+    }
+    auto* location = getEqFct();
+    location->lock();
+    if(_conflationPending && _now() - _lastPublication >= _minUpdateInterval) {
+      updateDoocsBuffer({});
+    }
+    location->unlock();
+  }
+
+  /********************************************************************************************************************/
+
+  void PropertyBase::setHistoryDecimation(double maxRate, HistoryAggregation aggregation) {
+    _historyDecimator = HistoryDecimator(maxRate, aggregation);
+    if(_historyDecimator.isActive()) {
+      _doocsUpdater.addDecimatedProperty(this);
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void PropertyBase::flushHistory() {
+    auto* location = getEqFct();
+    location->lock();
+    auto* sample = _historyDecimator.flush(HistoryDecimator::Clock::now());
+    if(sample) {
+      writeHistoryEntry(*sample);
+    }
+    location->unlock();
+  }
+
+  /********************************************************************************************************************/
+
+  void PropertyBase::setLazy(bool lazy) {
+    bool exactMatchingWithMacroPulseNumber = _macroPulseNumberSource.isInitialised() &&
+        _consistencyGroup.getMatchingMode() != DataConsistencyGroup::MatchingMode::none;
+    _lazy = lazy && supportsLazyUpdate() && !_publishZMQ && !exactMatchingWithMacroPulseNumber;
+  }
+
+  /********************************************************************************************************************/
+
+  void PropertyBase::fillDoocsBufferOrDefer() {
+    if(_lazy) {
+      _lazyUpdatePending = true;
+    }
+    else {
+      fillDoocsBuffer();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void PropertyBase::materialiseLazyUpdate() {
+    if(_lazyUpdatePending) {
+      // filling the buffer may update the time stamp of the DOOCS property, so preserve the one of the last update
+      auto timestamp = getDfct()->get_timestamp();
+      fillDoocsBuffer();
+      getDfct()->set_timestamp(timestamp);
+      _lazyUpdatePending = false;
+    }
+  }
+
+  /********************************************************************************************************************/
+
   void PropertyBase::subscribeToSharedPV(const std::string& pvName) {
     // Register a callback that updates this property's DOOCS buffer when another property writes to the shared PV.
     // Uses weak_ptr to avoid preventing destruction of this property.
     auto weakSelf = weak_from_this();
-    doocsAdapter.writeableVariablesWithMultipleProperties[pvName].emplace_back(
+    doocsAdapter.writeableVariablesWithMultipleProperties[pvName].push_back({getEqFct(),
         [weakSelf](bool handleLocking, const boost::shared_ptr<PropertyBase>& caller) {
           auto self = weakSelf.lock();
           if(!self) {
@@ -246,7 +409,34 @@ namespace ChimeraTK {
           if(handleLocking) {
             self->getEqFct()->unlock();
           }
-        });
+        }});
+  }
+
+  /********************************************************************************************************************/
+
+  void PropertyBase::propagateChange() {
+    // Reset the flag first, so a change arriving while the listeners are running is queued again
+    _propagationPending = false;
+    auto* location = getEqFct();
+    auto self = shared_from_this();
+    // The list is final once the server is running, so it can be used without holding the location lock
+    for(const auto& listener : callbacksOnChange()) {
+      // The listeners read the shared process variable and this property's DOOCS buffer. Both are written by RPC calls
+      // holding this property's location lock, so it is held while the listener runs, instead of reading them after
+      // the RPC call has released it. The locations are locked in the order of their addresses, like in the
+      // DoocsUpdater, so this cannot deadlock.
+      auto* first = std::min(location, listener.location);
+      auto* second = std::max(location, listener.location);
+      first->lock();
+      if(second != first) {
+        second->lock();
+      }
+      listener.callback(false, self);
+      if(second != first) {
+        second->unlock();
+      }
+      first->unlock();
+    }
   }
 
   /********************************************************************************************************************/
@@ -7,7 +7,7 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
-  TransferElement::SharedPtr RoutingDecoratorDomain::add(TransferElement::SharedPtr source) {
+  TransferElement::SharedPtr RoutingDecoratorDomain::add(TransferElement::SharedPtr source, size_t numberOfBuffers) {
     TransferElement::SharedPtr ret;
     callForType(source->getValueType(), [&](auto t) {
       using UserType = decltype(t);
@@ -18,14 +18,14 @@ namespace ChimeraTK {
       auto decorator = boost::make_shared<RoutingDecorator<UserType>>(sourceWithType);
 
       if(!_sourceMasters.contains(sourceId)) {
-        decorator->setupFan();
+        decorator->setupFan(numberOfBuffers);
         _sourceMasters[sourceId] = decorator;
       }
 
       else {
         auto sourceMaster = boost::dynamic_pointer_cast<RoutingDecorator<UserType>>(_sourceMasters[sourceId]);
         assert(sourceMaster);
-        decorator->addToFan(*sourceMaster);
+        decorator->addToFan(*sourceMaster, numberOfBuffers);
       }
       ret = decorator;
     });
@@ -54,18 +54,20 @@ namespace ChimeraTK {
       auto vn = source->getVersionNumber();
       assert(vn > VersionNumber{nullptr});
 
+      // The copies are written destructively, so the process arrays swap the buffer into their queues instead of
+      // copying it once more. Hence the data is copied only once for each but the last copy.
       unsigned nCopies = dec->getCopies().size();
       auto jt = dec->getCopies().begin();
       for(unsigned j = 0; j < nCopies - 1; ++j, ++jt) {
         auto dest = *jt;
         // currently we support only 1 channel
         dest->accessChannel(0) = source->accessChannel(0);
-        dest->write(vn);
+        dest->writeDestructively(vn);
       }
       // use swap for last copy
       auto dest = *jt;
       dest->accessChannel(0).swap(source->accessChannel(0));
-      dest->write(vn);
+      dest->writeDestructively(vn);
       ret = true;
     });
     return ret;
@@ -42,7 +42,7 @@ namespace ChimeraTK {
 
   StatusHandler::StatusHandler(EqFct* eqFct, boost::shared_ptr<DoocsUpdater> updater,
       boost::shared_ptr<ChimeraTK::NDRegisterAccessor<int32_t>> const& statusScalar,
-      boost::shared_ptr<ChimeraTK::NDRegisterAccessor<std::string>> const& statusString)
+      boost::shared_ptr<ChimeraTK::NDRegisterAccessor<std::string>> const& statusString, UpdatePriority priority)
   : _doocsUpdater(std::move(updater)), _eqFct(eqFct),
     _varPair(ChimeraTK::ScalarRegisterAccessor<int32_t>(statusScalar)) {
     if(!statusScalar->isReadable()) {
@@ -51,6 +51,7 @@ namespace ChimeraTK {
 
     _doocsUpdater->addVariable(
         _varPair._status, _eqFct, [this, capture0 = statusScalar->getId()] { updateError(capture0); });
+    _doocsUpdater->setPriority(_varPair._status.getId(), priority);
     if(statusString) {
       if(!statusString->isReadable()) {
         throw ChimeraTK::logic_error(statusString->getName() + " is not readable!");
@@ -59,6 +60,7 @@ namespace ChimeraTK {
 
       _doocsUpdater->addVariable(
           _varPair._message, _eqFct, [this, capture0 = statusString->getId()] { updateError(capture0); });
+      _doocsUpdater->setPriority(_varPair._message.getId(), priority);
     }
   }
 
@@ -11,10 +11,13 @@
 
 #include <libxml++/libxml++.h>
 
+#include <sched.h>
+
 #include <algorithm>
 #include <iostream>
 #include <locale>
 #include <regex>
+#include <sstream>
 #include <utility>
 
 namespace ChimeraTK {
@@ -61,6 +64,9 @@ namespace ChimeraTK {
       else if(node->get_name() == "import") {
         processImportNode(node, locationName);
       }
+      else if(node->get_name() == "event_builder") {
+        processEventBuilderNode(node, locationName);
+      }
       else if(node->get_name() == "has_history") {
         auto& locationInfo = _locationDefaults[locationName];
         locationInfo.useHasHistoryDefault = true;
@@ -86,6 +92,51 @@ namespace ChimeraTK {
         locationInfo.useDataMatchingDefault = true;
         locationInfo.dataMatching = evaluateDataMatching(getContentString(node));
       }
+      else if(node->get_name() == "max_rate") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useMaxRateDefault = true;
+        locationInfo.maxRate = evaluateNonNegative(getContentString(node));
+      }
+      else if(node->get_name() == "lazy") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useLazyDefault = true;
+        locationInfo.lazy = evaluateBool(getContentString(node));
+      }
+      else if(node->get_name() == "suppress_unchanged") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useSuppressUnchangedDefault = true;
+        locationInfo.suppressUnchanged = evaluateBool(getContentString(node));
+      }
+      else if(node->get_name() == "deadband_absolute") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useDeadbandAbsoluteDefault = true;
+        locationInfo.deadbandAbsolute = evaluateNonNegative(getContentString(node));
+      }
+      else if(node->get_name() == "deadband_relative") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useDeadbandRelativeDefault = true;
+        locationInfo.deadbandRelative = evaluateNonNegative(getContentString(node));
+      }
+      else if(node->get_name() == "history_max_rate") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useHistoryMaxRateDefault = true;
+        locationInfo.historyMaxRate = evaluateNonNegative(getContentString(node));
+      }
+      else if(node->get_name() == "history_aggregation") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useHistoryAggregationDefault = true;
+        locationInfo.historyAggregation = evaluateHistoryAggregation(getContentString(node));
+      }
+      else if(node->get_name() == "queue") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.useQueueDefault = true;
+        locationInfo.queue = evaluateQueue(node);
+      }
+      else if(node->get_name() == "priority") {
+        auto& locationInfo = _locationDefaults[locationName];
+        locationInfo.usePriorityDefault = true;
+        locationInfo.priority = evaluatePriority(getContentString(node));
+      }
       else if(node->get_name() == "D_spectrum") {
         processSpectrumNode(node, locationName);
       }
@@ -201,6 +252,79 @@ namespace ChimeraTK {
     else {
       propertyDescription.dataMatching = getDataMatchingDefault(locationName);
     }
+
+    auto maxRateNodes = propertyXmlElement->get_children("max_rate");
+    if(!maxRateNodes.empty()) {
+      propertyDescription.maxRate = evaluateNonNegative(getContentString(maxRateNodes.front()));
+    }
+    else {
+      propertyDescription.maxRate = getMaxRateDefault(locationName);
+    }
+
+    auto lazyNodes = propertyXmlElement->get_children("lazy");
+    if(!lazyNodes.empty()) {
+      propertyDescription.lazy = evaluateBool(getContentString(lazyNodes.front()));
+    }
+    else {
+      propertyDescription.lazy = getLazyDefault(locationName);
+    }
+
+    auto suppressUnchangedNodes = propertyXmlElement->get_children("suppress_unchanged");
+    if(!suppressUnchangedNodes.empty()) {
+      propertyDescription.suppressUnchanged = evaluateBool(getContentString(suppressUnchangedNodes.front()));
+    }
+    else {
+      propertyDescription.suppressUnchanged = getSuppressUnchangedDefault(locationName);
+    }
+
+    auto deadbandAbsoluteNodes = propertyXmlElement->get_children("deadband_absolute");
+    if(!deadbandAbsoluteNodes.empty()) {
+      propertyDescription.deadbandAbsolute = evaluateNonNegative(getContentString(deadbandAbsoluteNodes.front()));
+    }
+    else {
+      propertyDescription.deadbandAbsolute = getDeadbandAbsoluteDefault(locationName);
+    }
+
+    auto deadbandRelativeNodes = propertyXmlElement->get_children("deadband_relative");
+    if(!deadbandRelativeNodes.empty()) {
+      propertyDescription.deadbandRelative = evaluateNonNegative(getContentString(deadbandRelativeNodes.front()));
+    }
+    else {
+      propertyDescription.deadbandRelative = getDeadbandRelativeDefault(locationName);
+    }
+
+    auto historyMaxRateNodes = propertyXmlElement->get_children("history_max_rate");
+    if(!historyMaxRateNodes.empty()) {
+      propertyDescription.historyMaxRate = evaluateNonNegative(getContentString(historyMaxRateNodes.front()));
+    }
+    else {
+      propertyDescription.historyMaxRate = getHistoryMaxRateDefault(locationName);
+    }
+
+    auto historyAggregationNodes = propertyXmlElement->get_children("history_aggregation");
+    if(!historyAggregationNodes.empty()) {
+      propertyDescription.historyAggregation =
+          evaluateHistoryAggregation(getContentString(historyAggregationNodes.front()));
+    }
+    else {
+      propertyDescription.historyAggregation = getHistoryAggregationDefault(locationName);
+    }
+
+    auto queueNodes = propertyXmlElement->get_children("queue");
+    if(!queueNodes.empty()) {
+      propertyDescription.queue = evaluateQueue(queueNodes.front());
+    }
+    else {
+      propertyDescription.queue = getQueueDefault(locationName);
+    }
+
+    auto priorityNodes = propertyXmlElement->get_children("priority");
+    if(!priorityNodes.empty()) {
+      propertyDescription.priority = evaluatePriority(getContentString(priorityNodes.front()));
+    }
+    else {
+      propertyDescription.priority = getPriorityDefault(locationName);
+    }
   }
 
   /********************************************************************************************************************/
@@ -462,6 +586,10 @@ namespace ChimeraTK {
     errInfo.statusCodeSource = s;
     // matching status message source is found automatically by naming convention - if it exists
     errInfo.statusStringSource = s + "_message";
+    const auto* priorityAttribute = setErrorXml->get_attribute("priority");
+    if(priorityAttribute) {
+      errInfo.priority = evaluatePriority(priorityAttribute->get_value());
+    }
     _userProcessVariables.insert(s);
     if(_inputVariables.find(errInfo.statusStringSource) != _inputVariables.end()) {
       _userProcessVariables.insert(errInfo.statusStringSource);
@@ -550,6 +678,15 @@ namespace ChimeraTK {
         autoPropertyDescription->persist = getPersistDefault(locationName);
         autoPropertyDescription->macroPulseNumberSource = getMacroPulseNumberSourceDefault(locationName);
         autoPropertyDescription->dataMatching = getDataMatchingDefault(locationName);
+        autoPropertyDescription->maxRate = getMaxRateDefault(locationName);
+        autoPropertyDescription->lazy = getLazyDefault(locationName);
+        autoPropertyDescription->suppressUnchanged = getSuppressUnchangedDefault(locationName);
+        autoPropertyDescription->deadbandAbsolute = getDeadbandAbsoluteDefault(locationName);
+        autoPropertyDescription->deadbandRelative = getDeadbandRelativeDefault(locationName);
+        autoPropertyDescription->historyMaxRate = getHistoryMaxRateDefault(locationName);
+        autoPropertyDescription->historyAggregation = getHistoryAggregationDefault(locationName);
+        autoPropertyDescription->queue = getQueueDefault(locationName);
+        autoPropertyDescription->priority = getPriorityDefault(locationName);
 
         addDescription(autoPropertyDescription);
       }
@@ -592,6 +729,97 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void VariableMapper::processUpdaterNode(xmlpp::Node const* updaterNode) {
+    for(auto const& node : updaterNode->get_children()) {
+      if(nodeIsWhitespace(node)) {
+        continue;
+      }
+      if(dynamic_cast<xmlpp::CommentNode const*>(node)) {
+        continue;
+      }
+
+      if(node->get_name() == "threads") {
+        _updaterConfig.nThreads = evaluateUnsigned(getContentString(node));
+        if(_updaterConfig.nThreads < 1) {
+          throw std::invalid_argument("Error parsing xml file in updater: Number of threads must be at least 1.");
+        }
+      }
+      else if(node->get_name() == "batch_size") {
+        _updaterConfig.batchSize = evaluateUnsigned(getContentString(node));
+        if(_updaterConfig.batchSize < 1) {
+          throw std::invalid_argument("Error parsing xml file in updater: batch_size must be at least 1.");
+        }
+      }
+      else if(node->get_name() == "batch_time_budget") {
+        _updaterConfig.batchTimeBudget = std::chrono::microseconds(evaluateUnsigned(getContentString(node)));
+      }
+      else if(node->get_name() == "direct_dispatch") {
+        _updaterConfig.directDispatch = evaluateBool(getContentString(node));
+      }
+      else if(node->get_name() == "cpu_affinity") {
+        // comma separated list of CPU numbers
+        _updaterConfig.cpuAffinity.clear();
+        std::stringstream cpus(getContentString(node));
+        std::string cpu;
+        while(std::getline(cpus, cpu, ',')) {
+          // CPU_SET() does not check the range, so invalid CPU numbers must be rejected here. Negative numbers are
+          // already rejected by evaluateUnsigned().
+          auto cpuNumber = evaluateUnsigned(cpu);
+          if(cpuNumber >= CPU_SETSIZE) {
+            throw std::invalid_argument("Error parsing xml file in updater: cpu_affinity contains a CPU beyond " +
+                std::to_string(CPU_SETSIZE - 1) + ": " + cpu);
+          }
+          _updaterConfig.cpuAffinity.push_back(int(cpuNumber));
+        }
+      }
+      else if(node->get_name() == "realtime_priority") {
+        _updaterConfig.realtimePriority = int(evaluateUnsigned(getContentString(node)));
+        if(_updaterConfig.realtimePriority > 99) {
+          throw std::invalid_argument("Error parsing xml file in updater: realtime_priority must be at most 99.");
+        }
+      }
+      else if(node->get_name() == "lock_memory") {
+        _updaterConfig.lockMemory = evaluateBool(getContentString(node));
+      }
+      else if(node->get_name() == "spin_time") {
+        _updaterConfig.spinTime = std::chrono::microseconds(evaluateUnsigned(getContentString(node)));
+      }
+      else if(node->get_name() == "measure_latency") {
+        _updaterConfig.measureLatency = evaluateBool(getContentString(node));
+      }
+      else if(node->get_name() == "defer_busy_locations") {
+        _updaterConfig.deferBusyLocations = evaluateBool(getContentString(node));
+      }
+      else if(node->get_name() == "fairness_limit") {
+        _updaterConfig.fairnessLimit = evaluateUnsigned(getContentString(node));
+      }
+      else if(node->get_name() == "async_propagation") {
+        _updaterConfig.asyncPropagation = evaluateBool(getContentString(node));
+      }
+      else {
+        throw std::invalid_argument(
+            std::string("Error parsing xml file in updater: Unknown node '") + node->get_name() + "'");
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void VariableMapper::processEventBuilderNode(xmlpp::Node const* node, const std::string& locationName) {
+    if(!evaluateBool(getContentString(node))) {
+      _updaterConfig.eventBuilderTimeouts.erase(locationName);
+      return;
+    }
+    std::chrono::microseconds timeout{10000};
+    const auto* timeoutAttribute = asXmlElement(node)->get_attribute("timeout");
+    if(timeoutAttribute) {
+      timeout = std::chrono::microseconds(evaluateUnsigned(timeoutAttribute->get_value()));
+    }
+    _updaterConfig.eventBuilderTimeouts[locationName] = timeout;
+  }
+
+  /********************************************************************************************************************/
+
   void VariableMapper::prepareOutput(const std::string& xmlFile, std::set<std::string> inputVariables) {
     clear();
     _inputVariables = std::move(inputVariables);
@@ -635,6 +863,36 @@ namespace ChimeraTK {
         else if(mainNode->get_name() == "data_matching") {
           _globalDefaults.dataMatching = evaluateDataMatching(getContentString(mainNode));
         }
+        else if(mainNode->get_name() == "max_rate") {
+          _globalDefaults.maxRate = evaluateNonNegative(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "lazy") {
+          _globalDefaults.lazy = evaluateBool(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "suppress_unchanged") {
+          _globalDefaults.suppressUnchanged = evaluateBool(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "deadband_absolute") {
+          _globalDefaults.deadbandAbsolute = evaluateNonNegative(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "deadband_relative") {
+          _globalDefaults.deadbandRelative = evaluateNonNegative(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "history_max_rate") {
+          _globalDefaults.historyMaxRate = evaluateNonNegative(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "history_aggregation") {
+          _globalDefaults.historyAggregation = evaluateHistoryAggregation(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "queue") {
+          _globalDefaults.queue = evaluateQueue(mainNode);
+        }
+        else if(mainNode->get_name() == "priority") {
+          _globalDefaults.priority = evaluatePriority(getContentString(mainNode));
+        }
+        else if(mainNode->get_name() == "updater") {
+          processUpdaterNode(mainNode);
+        }
         else {
           throw std::invalid_argument(
               std::string("Error parsing xml file ") + xmlFile + ": Unknown node '" + mainNode->get_name() + "'");
@@ -693,6 +951,7 @@ namespace ChimeraTK {
     _locationDefaults.clear();
     _globalDefaults = PropertyAttributes();
     _descriptions.clear();
+    _updaterConfig = UpdaterConfig();
   }
 
   /********************************************************************************************************************/
@@ -721,6 +980,41 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  size_t VariableMapper::evaluateUnsigned(const std::string& txt) {
+    size_t pos = 0;
+    unsigned long value = 0;
+    try {
+      value = std::stoul(txt, &pos);
+    }
+    catch(std::exception&) {
+      pos = 0;
+    }
+    if(pos == 0 || pos != txt.size() || txt.find('-') != std::string::npos) {
+      throw std::invalid_argument(std::string("Error parsing xml file: could not convert to unsigned integer: ") + txt);
+    }
+    return value;
+  }
+
+  /********************************************************************************************************************/
+
+  double VariableMapper::evaluateNonNegative(const std::string& txt) {
+    size_t pos = 0;
+    double value = -1.;
+    try {
+      value = std::stod(txt, &pos);
+    }
+    catch(std::exception&) {
+      pos = 0;
+    }
+    if(pos == 0 || pos != txt.size() || !(value >= 0.)) {
+      throw std::invalid_argument(
+          std::string("Error parsing xml file: could not convert to non-negative number: ") + txt);
+    }
+    return value;
+  }
+
+  /********************************************************************************************************************/
+
   DataConsistencyGroup::MatchingMode VariableMapper::evaluateDataMatching(const std::string& txt) {
     DataConsistencyGroup::MatchingMode dataMatching;
     if(txt == "exact") {
@@ -740,6 +1034,64 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  HistoryAggregation VariableMapper::evaluateHistoryAggregation(const std::string& txt) {
+    if(txt == "last") {
+      return HistoryAggregation::last;
+    }
+    if(txt == "min") {
+      return HistoryAggregation::min;
+    }
+    if(txt == "max") {
+      return HistoryAggregation::max;
+    }
+    if(txt == "mean") {
+      return HistoryAggregation::mean;
+    }
+    throw std::invalid_argument("Unknown history aggregation specified in xml file: " + txt);
+  }
+
+  /********************************************************************************************************************/
+
+  QueueConfig VariableMapper::evaluateQueue(xmlpp::Node const* node) {
+    QueueConfig queue;
+    const auto* element = asXmlElement(node);
+    const auto* depthAttribute = element->get_attribute("depth");
+    if(depthAttribute) {
+      queue.depth = evaluateUnsigned(depthAttribute->get_value());
+    }
+    const auto* policyAttribute = element->get_attribute("policy");
+    if(policyAttribute) {
+      std::string policy = policyAttribute->get_value();
+      if(policy == "all") {
+        queue.policy = QueuePolicy::all;
+      }
+      else if(policy == "latest") {
+        queue.policy = QueuePolicy::latest;
+      }
+      else {
+        throw std::invalid_argument("Unknown queue policy specified in xml file: " + policy);
+      }
+    }
+    return queue;
+  }
+
+  /********************************************************************************************************************/
+
+  UpdatePriority VariableMapper::evaluatePriority(const std::string& txt) {
+    if(txt == "low") {
+      return UpdatePriority::low;
+    }
+    if(txt == "normal") {
+      return UpdatePriority::normal;
+    }
+    if(txt == "high") {
+      return UpdatePriority::high;
+    }
+    throw std::invalid_argument("Unknown priority specified in xml file: " + txt);
+  }
+
+  /********************************************************************************************************************/
+
   std::string VariableMapper::getContentString(xmlpp::Node const* node) {
     for(auto const& subNode : node->get_children()) {
       const auto* nodeAsText = dynamic_cast<const xmlpp::TextNode*>(subNode);
@@ -816,6 +1168,96 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  double VariableMapper::getMaxRateDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useMaxRateDefault) {
+      return locationInfo.maxRate;
+    }
+    return _globalDefaults.maxRate;
+  }
+
+  /********************************************************************************************************************/
+
+  bool VariableMapper::getLazyDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useLazyDefault) {
+      return locationInfo.lazy;
+    }
+    return _globalDefaults.lazy;
+  }
+
+  /********************************************************************************************************************/
+
+  bool VariableMapper::getSuppressUnchangedDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useSuppressUnchangedDefault) {
+      return locationInfo.suppressUnchanged;
+    }
+    return _globalDefaults.suppressUnchanged;
+  }
+
+  /********************************************************************************************************************/
+
+  double VariableMapper::getDeadbandAbsoluteDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useDeadbandAbsoluteDefault) {
+      return locationInfo.deadbandAbsolute;
+    }
+    return _globalDefaults.deadbandAbsolute;
+  }
+
+  /********************************************************************************************************************/
+
+  double VariableMapper::getDeadbandRelativeDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useDeadbandRelativeDefault) {
+      return locationInfo.deadbandRelative;
+    }
+    return _globalDefaults.deadbandRelative;
+  }
+
+  /********************************************************************************************************************/
+
+  double VariableMapper::getHistoryMaxRateDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useHistoryMaxRateDefault) {
+      return locationInfo.historyMaxRate;
+    }
+    return _globalDefaults.historyMaxRate;
+  }
+
+  /********************************************************************************************************************/
+
+  HistoryAggregation VariableMapper::getHistoryAggregationDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useHistoryAggregationDefault) {
+      return locationInfo.historyAggregation;
+    }
+    return _globalDefaults.historyAggregation;
+  }
+
+  /********************************************************************************************************************/
+
+  QueueConfig VariableMapper::getQueueDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.useQueueDefault) {
+      return locationInfo.queue;
+    }
+    return _globalDefaults.queue;
+  }
+
+  /********************************************************************************************************************/
+
+  UpdatePriority VariableMapper::getPriorityDefault(std::string const& locationName) {
+    auto locationInfo = _locationDefaults[locationName];
+    if(locationInfo.usePriorityDefault) {
+      return locationInfo.priority;
+    }
+    return _globalDefaults.priority;
+  }
+
+  /********************************************************************************************************************/
+
   std::string VariableMapper::getAttributeValue(const xmlpp::Element* node, std::string const& attributeName) {
     auto* attribute = node->get_attribute(attributeName);
     if(!attribute) {
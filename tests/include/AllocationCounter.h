@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+/**
+ * Counts heap allocations, either of the calling thread or of the threads started by DoocsUpdater::run().
+ *
+ * malloc(), calloc() and realloc() are replaced for the whole process, so allocations inside DOOCS, DeviceAccess and
+ * other C or C++ libraries are counted as well (the global operator new uses malloc()). Hence this header must only be
+ * included by a single source file of a test executable. Aligned allocations are not counted.
+ */
+
+#include <sys/prctl.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+}
+
+namespace AllocationCounter {
+
+  inline std::atomic<size_t> nAllocations{0};
+  inline std::atomic<bool> isCountingUpdater{false};
+  inline thread_local bool isCountingThisThread{false};
+
+  /// Whether the calling thread has been started by DoocsUpdater::run(). These threads are named "DoocsUpd...".
+  inline bool isUpdaterThread() {
+    char name[16]{};
+    prctl(PR_GET_NAME, name);
+    return std::strncmp(name, "DoocsUpd", 8) == 0;
+  }
+
+  inline void count() {
+    if(isCountingThisThread || (isCountingUpdater && isUpdaterThread())) {
+      ++nAllocations;
+    }
+  }
+
+  /// Count the allocations done by the calling thread while executing the given function
+  template<typename FUNCTION>
+  size_t countIn(FUNCTION function) {
+    nAllocations = 0;
+    isCountingThisThread = true;
+    function();
+    isCountingThisThread = false;
+    return nAllocations;
+  }
+
+  /// Count the allocations done by the update threads while the given function is executed. The function has to wait
+  /// until the updates it triggers have been processed.
+  template<typename FUNCTION>
+  size_t countUpdaterIn(FUNCTION function) {
+    nAllocations = 0;
+    isCountingUpdater = true;
+    function();
+    isCountingUpdater = false;
+    return nAllocations;
+  }
+
+} // namespace AllocationCounter
+
+/**********************************************************************************************************************/
+
+extern "C" void* malloc(size_t size) noexcept {
+  AllocationCounter::count();
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t n, size_t size) noexcept {
+  AllocationCounter::count();
+  return __libc_calloc(n, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) noexcept {
+  AllocationCounter::count();
+  return __libc_realloc(ptr, size);
+}
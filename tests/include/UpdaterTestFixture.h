@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+// boost unit_test needs to be included before serverBasedTestTools.h
+
+#include "DoocsAdapter.h"
+#include "DoocsUpdater.h"
+#include "serverBasedTestTools.h"
+
+#include <ChimeraTK/ControlSystemAdapter/Testing/ReferenceTestApplication.h>
+
+#include <doocs-server-test-helper/doocsServerTestHelper.h>
+
+extern const char* object_name;
+#include <doocs-server-test-helper/ThreadedDoocsServer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Tests may define UPDATER_TEST_STARTUP_CODE before including this header, to run code once the server is initialised
+// (e.g. dmsg_start() for ZeroMQ)
+#ifdef UPDATER_TEST_STARTUP_CODE
+DOOCS_ADAPTER_DEFAULT_FIXTURE_STATIC_APPLICATION_WITH_CODE(UPDATER_TEST_STARTUP_CODE)
+#else
+DOOCS_ADAPTER_DEFAULT_FIXTURE_STATIC_APPLICATION
+#endif
+
+/**
+ * Helpers for the server tests of the DoocsUpdater.
+ *
+ * The mapping files of these tests map the TO_DEVICE variables of the reference application into the location CONTROL.
+ * Each run of the main loop copies the changed TO_DEVICE variables to the FROM_DEVICE variables, which are mapped into
+ * the locations under test.
+ */
+namespace UpdaterTest {
+
+  /// Write a value to the property //CONTROL/<name>
+  template<typename T>
+  void write(const std::string& name, const T& value) {
+    DoocsServerTestHelper::doocsSet<T>("//CONTROL/" + name, value);
+  }
+
+  template<typename T>
+  void write(const std::string& name, const std::vector<T>& value) {
+    DoocsServerTestHelper::doocsSet<T>("//CONTROL/" + name, value);
+  }
+
+  /// Run the main loop of the reference application once, so the values written to CONTROL are sent to the updater
+  inline void runMainLoop() {
+    GlobalFixture::referenceTestApplication.runMainLoopOnce();
+  }
+
+  /// Check whether the property has the given value. Floating point values are compared with a relative tolerance.
+  /// Spectra have to be compared as std::vector<float>.
+  template<typename T>
+  bool hasValue(const std::string& address, const T& expected) {
+    if constexpr(std::is_floating_point_v<T>) {
+      return std::abs(DoocsServerTestHelper::doocsGet<T>(address) - expected) <=
+          T(1e-6) * std::max(T(1), std::abs(expected));
+    }
+    else {
+      return DoocsServerTestHelper::doocsGet<T>(address) == expected;
+    }
+  }
+
+  template<typename T>
+  bool hasValue(const std::string& address, const std::vector<T>& expected) {
+    return DoocsServerTestHelper::doocsGetArray<T>(address) == expected;
+  }
+
+  /// Wait until the property has the given value
+  template<typename T>
+  void expect(const std::string& address, const T& expected) {
+    BOOST_TEST_CONTEXT("Property " << address) {
+      CHECK_WITH_TIMEOUT(hasValue(address, expected));
+    }
+  }
+
+  /// Check that the property still has the given value after the updater had the time to process pending updates
+  template<typename T>
+  void expectUnchanged(const std::string& address, const T& expected) {
+    usleep(100000);
+    BOOST_TEST_CONTEXT("Property " << address) {
+      BOOST_CHECK(hasValue(address, expected));
+    }
+  }
+
+  /**
+   * Holds the lock of the location of the given property, like a busy RPC call. Properties of this location must not
+   * be read while it is held, since the read would wait for the lock.
+   */
+  class LocationLock {
+   public:
+    explicit LocationLock(const std::string& propertyAddress)
+    : _location(getLocationFromPropertyAddress(propertyAddress)) {
+      _location->lock();
+    }
+    ~LocationLock() { unlock(); }
+
+    LocationLock(const LocationLock&) = delete;
+    LocationLock& operator=(const LocationLock&) = delete;
+
+    void unlock() {
+      if(_isLocked) {
+        _location->unlock();
+        _isLocked = false;
+      }
+    }
+
+   private:
+    EqFct* _location;
+    bool _isLocked{true};
+  };
+
+  /// The updater of the server
+  inline ChimeraTK::DoocsUpdater& updater() {
+    return *doocsAdapter.updater;
+  }
+
+} // namespace UpdaterTest
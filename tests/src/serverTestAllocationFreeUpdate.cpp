@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestAllocationFreeUpdate
+
+#include <eq_dmsg.h>
+
+#define UPDATER_TEST_STARTUP_CODE dmsg_start();
+#include "UpdaterTestFixture.h"
+
+#include "AllocationCounter.h"
+#include "PropertyBase.h"
+
+#include <numeric>
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+static constexpr int nWarmUpIterations = 10;
+static constexpr int nIterations = 100;
+
+static const std::vector<std::string> updatedProperties{"INT", "INT_AS_DOUBLE", "INT_ARRAY", "INT_ARRAY_AS_FLOAT",
+    "SPECTRUM", "BUFFERED_SPECTRUM", "IFFF", "IIII", "IIII_COPY", "XY"};
+
+/**********************************************************************************************************************/
+
+/// Write new values to all sources and wait until the update thread has processed them
+void step(int value) {
+  std::vector<int> intArray(10);
+  std::iota(intArray.begin(), intArray.end(), value);
+  std::vector<float> floatArray(intArray.begin(), intArray.end());
+  std::vector<double> doubleArray(intArray.begin(), intArray.end());
+
+  write("INT", value);
+  write("FLOAT", float(value) / 2);
+  write("DOUBLE", double(value) / 4);
+  write("SHORT", value % 1000);
+  write("IIII", std::vector<int>{value, value + 1, value + 2, value + 3});
+  write("INT_ARRAY", intArray);
+  DoocsServerTestHelper::doocsSetSpectrum("//CONTROL/FLOAT_ARRAY", floatArray);
+  write("DOUBLE_ARRAY", doubleArray);
+
+  // The buffered spectrum matches the data with the macro pulse number, so all updates need the same version number
+  GlobalFixture::referenceTestApplication.versionNumber = VersionNumber();
+  runMainLoop();
+
+  CHECK_WITH_TIMEOUT(hasValue("//UPDATES/INT", value) && hasValue("//UPDATES/INT_ARRAY", intArray) &&
+      hasValue("//UPDATES/SPECTRUM", floatArray));
+}
+
+/**********************************************************************************************************************/
+
+/// Run the steady-state updates, return the number of allocations by the update thread
+size_t countAllocations() {
+  static int value = 0;
+  for(int i = 0; i < nWarmUpIterations; ++i) {
+    step(++value);
+  }
+  return AllocationCounter::countUpdaterIn([&] {
+    for(int i = 0; i < nIterations; ++i) {
+      step(++value);
+    }
+  });
+}
+
+/**********************************************************************************************************************/
+
+/// All property types, the fan-out and the ConvertingDecorator, processed by the update thread of the server
+BOOST_AUTO_TEST_CASE(testUpdates) {
+  BOOST_CHECK_EQUAL(countAllocations(), 0);
+
+  // make sure the updates have actually been processed
+  int value = DoocsServerTestHelper::doocsGet<int>("//UPDATES/INT");
+  expect("//UPDATES/INT_AS_DOUBLE", double(value));
+  std::vector<float> expected(10);
+  std::iota(expected.begin(), expected.end(), float(value));
+  expect("//UPDATES/INT_ARRAY_AS_FLOAT", expected);
+
+  auto ifff = [] {
+    LocationLock lock("//UPDATES/IFFF");
+    return *getDoocsProperty<D_ifff>("//UPDATES/IFFF")->value();
+  };
+  CHECK_WITH_TIMEOUT(ifff().i1_data == value);
+  BOOST_CHECK_CLOSE(ifff().f2_data, float(value) / 4, 1e-4);
+  auto iiii = [] {
+    LocationLock lock("//UPDATES/IIII_COPY");
+    return *getDoocsProperty<D_iiii>("//UPDATES/IIII_COPY")->value();
+  };
+  CHECK_WITH_TIMEOUT(iiii().i4_data == value + 3);
+}
+
+/**********************************************************************************************************************/
+
+/// Publishing via ZeroMQ is not covered: DOOCS and libzmq allocate message buffers while sending. The number of
+/// allocations is only reported.
+BOOST_AUTO_TEST_CASE(testZeroMQ) {
+  {
+    LocationLock lock("//UPDATES/INT");
+    for(const auto& name : updatedProperties) {
+      auto* property = dynamic_cast<PropertyBase*>(getDoocsProperty<D_fct>("//UPDATES/" + name));
+      BOOST_REQUIRE(property);
+      property->publishZeroMQ();
+    }
+  }
+
+  auto nAllocations = countAllocations();
+  BOOST_TEST_MESSAGE("Allocations per update with ZeroMQ publication: " << double(nAllocations) / nIterations);
+}
+
+/**********************************************************************************************************************/
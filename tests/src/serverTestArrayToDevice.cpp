@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestArrayToDevice
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// The unbuffered spectrum is copied into the accessor in one go, the arrays element by element
+BOOST_AUTO_TEST_CASE(testWriteArrays) {
+  std::vector<float> spectrum{1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5, 10.5};
+  std::vector<int> array{-5, -4, -3, -2, -1, 0, 1, 2, 3, 4};
+  std::vector<double> doubleArray{0.25, 0.5, 0.75, 1, 1.25, 1.5, 1.75, 2, 2.25, 2.5};
+
+  DoocsServerTestHelper::doocsSetSpectrum("//CONTROL/SPECTRUM", spectrum);
+  write("ARRAY", array);
+  write("DOUBLE_ARRAY", doubleArray);
+  runMainLoop();
+
+  // we have to get the data as float in order to work with spectra
+  expect("//READBACK/SPECTRUM", spectrum);
+  expect("//READBACK/ARRAY", array);
+  expect("//READBACK/DOUBLE_ARRAY", doubleArray);
+}
+
+/**********************************************************************************************************************/
+
+/// A too long array is truncated. The property gets back its length and keeps the values which have been sent.
+BOOST_AUTO_TEST_CASE(testWriteTooLongArray) {
+  std::vector<int> tooLong{10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21};
+  std::vector<int> expected(tooLong.begin(), tooLong.begin() + 10);
+
+  write("ARRAY", tooLong);
+  runMainLoop();
+
+  expect("//READBACK/ARRAY", expected);
+  BOOST_CHECK(hasValue("//CONTROL/ARRAY", expected));
+}
+
+/**********************************************************************************************************************/
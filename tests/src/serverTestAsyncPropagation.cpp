@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestAsyncPropagation
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// A value written to FIRST is propagated to SECOND by the propagation thread
+BOOST_AUTO_TEST_CASE(testPropagation) {
+  DoocsServerTestHelper::doocsSet<int>("//FIRST/SCALAR", 42);
+  DoocsServerTestHelper::doocsSet<int>("//FIRST/ARRAY", {1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+
+  expect("//SECOND/SCALAR", 42);
+  expect("//SECOND/ARRAY", std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+}
+
+/**********************************************************************************************************************/
+
+/// The RPC call does not wait for the location of the other property. The change is applied once it is free, and
+/// several changes in the meantime end with the latest value.
+BOOST_AUTO_TEST_CASE(testBusyLocation) {
+  LocationLock lock("//SECOND/SCALAR");
+  DoocsServerTestHelper::doocsSet<int>("//FIRST/SCALAR", 120);
+  DoocsServerTestHelper::doocsSet<int>("//FIRST/SCALAR", 121);
+  DoocsServerTestHelper::doocsSet<int>("//FIRST/SCALAR", 122);
+  BOOST_CHECK(hasValue("//FIRST/SCALAR", 122));
+  lock.unlock();
+
+  expect("//SECOND/SCALAR", 122);
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestBatchMode
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testSingleUpdates) {
+  write("INT", 42);
+  runMainLoop();
+  expect("//FIRST/A", 42);
+
+  write("IIII", std::vector<int>{1, 2, 3, 4});
+  runMainLoop();
+  // we have to get the data as float in order to work with spectra
+  expect("//SECOND/B", std::vector<float>{1, 2, 3, 4});
+}
+
+/**********************************************************************************************************************/
+
+/// While FIRST is held, the updates pile up and are processed as batches afterwards. Each property must end up with
+/// the latest value, and the updates must have been processed with fewer lock rounds than updates.
+BOOST_AUTO_TEST_CASE(testBatches) {
+  auto before = updater().getBatchStatistics();
+  LocationLock lock("//FIRST/A");
+  for(int i = 0; i < 5; ++i) {
+    write("INT", 100 + i);
+    write("FLOAT", 0.5F + float(i));
+    write("IIII", std::vector<int>{i, i + 1, i + 2, i + 3});
+    runMainLoop();
+  }
+  lock.unlock();
+
+  expect("//FIRST/A", 104);
+  expect("//FIRST/C", 4.5F);
+  expect("//SECOND/B", std::vector<float>{4, 5, 6, 7});
+
+  auto after = updater().getBatchStatistics();
+  BOOST_CHECK_GT(after.nLockRounds, before.nLockRounds);
+  BOOST_CHECK_GT(after.nNotifications - before.nNotifications, after.nLockRounds - before.nLockRounds);
+}
+
+/**********************************************************************************************************************/
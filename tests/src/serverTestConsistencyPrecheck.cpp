@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestConsistencyPrecheck
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// An update without the matching macro pulse number is not published. The updater finds this out without the
+/// location lock, so it does not wait for a busy location and continues with the updates of other locations.
+BOOST_AUTO_TEST_CASE(testInconsistentUpdateDoesNotLock) {
+  // consistent start
+  GlobalFixture::referenceTestApplication.versionNumber = VersionNumber();
+  write("MACRO_PULSE_NUMBER", 1000U);
+  write("INT", 1);
+  runMainLoop();
+  expect("//DATA/A", 1);
+
+  VersionNumber version;
+  GlobalFixture::referenceTestApplication.versionNumber = version;
+
+  LocationLock lock("//DATA/A");
+  write("INT", 2);
+  runMainLoop();
+  write("FLOAT", 2.5F);
+  runMainLoop();
+  expect("//OTHER/B", 2.5F);
+  lock.unlock();
+
+  expectUnchanged("//DATA/A", 1);
+
+  // the matching macro pulse number completes the update
+  write("MACRO_PULSE_NUMBER", 1001U);
+  runMainLoop();
+  expect("//DATA/A", 2);
+}
+
+/**********************************************************************************************************************/
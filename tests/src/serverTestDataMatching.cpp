@@ -6,6 +6,7 @@
 #include <boost/test/included/unit_test.hpp>
 // boost unit_test needs to be included before serverBasedTestTools.h
 #include "DoocsAdapter.h"
+#include "PropertyBase.h"
 #include "serverBasedTestTools.h"
 
 #include <ChimeraTK/ControlSystemAdapter/Testing/ReferenceTestApplication.h>
@@ -128,3 +129,40 @@ BOOST_FIXTURE_TEST_CASE(testProcessScalar, DataMatchingFixture) {
 }
 
 /**********************************************************************************************************************/
+
+/// With historized data matching, a macro pulse number arriving after a newer value is matched with the older value
+/// from the history. Such matches are counted.
+BOOST_FIXTURE_TEST_CASE(testCountHistorizedMatches, DataMatchingFixture) {
+  std::cout << "testCountHistorizedMatches" << std::endl;
+
+  auto getNumberOfHistorizedMatches = [] {
+    auto* location = getLocationFromPropertyAddress("//DOUBLE/FROM_DEVICE_SCALAR");
+    location->lock();
+    auto* property = dynamic_cast<PropertyBase*>(getDoocsProperty<D_fct>("//DOUBLE/FROM_DEVICE_SCALAR"));
+    BOOST_REQUIRE(property);
+    auto nMatches = property->getNumberOfHistorizedMatches();
+    location->unlock();
+    return nMatches;
+  };
+
+  sendUpdate();
+  ExtendedTestApplication::runMainLoopOnce();
+  checkReceivedValues();
+  auto nMatches = getNumberOfHistorizedMatches();
+
+  // two values, then the macro pulse number of the first one
+  ChimeraTK::VersionNumber vnFirst;
+  sendUpdate(false, true, vnFirst);
+  double dValFirst = sendDouble;
+  ExtendedTestApplication::runMainLoopOnce();
+  sendUpdate(false, true, {});
+  ExtendedTestApplication::runMainLoopOnce();
+  sendUpdate(true, false, vnFirst);
+  ExtendedTestApplication::runMainLoopOnce();
+
+  TEST_WITH_TIMEOUT(
+      std::abs(DoocsServerTestHelper::doocsGet<double>("//DOUBLE/FROM_DEVICE_SCALAR") - dValFirst) < 1e-6);
+  TEST_WITH_TIMEOUT(getNumberOfHistorizedMatches() > nMatches);
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestDeferBusyLocations
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// While FIRST is held, the update of A is parked, and the updater continues with the later update of THIRD. Without
+/// deferral, the updater would wait for FIRST.
+BOOST_AUTO_TEST_CASE(testParkedUpdates) {
+  auto* first = getLocationFromPropertyAddress("//FIRST/A");
+  auto nParked = updater().getParkedTimeStatistics(first).nUpdates;
+
+  LocationLock lock("//FIRST/A");
+  write("INT", 42);
+  runMainLoop();
+  write("FLOAT", 7.5F);
+  runMainLoop();
+  expect("//THIRD/C", 7.5F);
+  lock.unlock();
+
+  expect("//FIRST/A", 42);
+  expect("//SECOND/A", 42);
+  CHECK_WITH_TIMEOUT(updater().getParkedTimeStatistics(first).nUpdates == nParked + 1);
+}
+
+/**********************************************************************************************************************/
+
+/// Two properties share the location SECOND while the location FIRST is held. The update of SECOND/B must not overtake
+/// the older update of FIRST/A and SECOND/A, which is parked because FIRST is busy. Other locations are still updated.
+BOOST_AUTO_TEST_CASE(testParkedUpdatesKeepOrder) {
+  auto* first = getLocationFromPropertyAddress("//FIRST/A");
+  auto* second = getLocationFromPropertyAddress("//SECOND/B");
+  auto nParkedFirst = updater().getParkedTimeStatistics(first).nUpdates;
+  auto nParkedSecond = updater().getParkedTimeStatistics(second).nUpdates;
+
+  write("INT", 43);
+  write("IIII", std::vector<int>{1, 2, 3, 4});
+
+  LocationLock lock("//FIRST/A");
+  // The application writes /INT/FROM_DEVICE_SCALAR before /IIII/FROM_DEVICE, see ExtendedTestApplication
+  runMainLoop();
+
+  // The update of THIRD/C is written after the update of SECOND/B, so once it has arrived, the update of SECOND/B has
+  // been processed by the updater as well
+  write("FLOAT", 8.5F);
+  runMainLoop();
+  expect("//THIRD/C", 8.5F);
+  BOOST_CHECK(hasValue("//SECOND/A", 42));
+  // we have to get the data as float in order to work with spectra
+  BOOST_CHECK(hasValue("//SECOND/B", std::vector<float>{0, 0, 0, 0}));
+  lock.unlock();
+
+  expect("//FIRST/A", 43);
+  expect("//SECOND/A", 43);
+  expect("//SECOND/B", std::vector<float>{1, 2, 3, 4});
+
+  // The update of A has been parked because FIRST was busy, the update of B because SECOND was used by the parked
+  // update of A
+  CHECK_WITH_TIMEOUT(updater().getParkedTimeStatistics(first).nUpdates > nParkedFirst);
+  CHECK_WITH_TIMEOUT(updater().getParkedTimeStatistics(second).nUpdates > nParkedSecond);
+}
+
+/**********************************************************************************************************************/
+
+/// Parked updates superseded by a newer one are skipped, but only once the location is free. Skipping completes the
+/// transfer of the accessor, which the properties of the location read from.
+BOOST_AUTO_TEST_CASE(testSupersededUpdatesWaitForLocation) {
+  auto nSkipped = updater().getNumberOfSkippedUpdates();
+
+  LocationLock lock("//LATEST/D");
+  for(int i = 0; i < 5; ++i) {
+    write("DOUBLE", 10.5 + i);
+    runMainLoop();
+  }
+  // The update of THIRD/C is written last, so once it has arrived, the updates of D have been parked
+  write("FLOAT", 9.5F);
+  runMainLoop();
+  expect("//THIRD/C", 9.5F);
+  usleep(10000);
+  BOOST_CHECK_EQUAL(updater().getNumberOfSkippedUpdates(), nSkipped);
+  lock.unlock();
+
+  expect("//LATEST/D", 14.5);
+  CHECK_WITH_TIMEOUT(updater().getNumberOfSkippedUpdates() > nSkipped);
+}
+
+/**********************************************************************************************************************/
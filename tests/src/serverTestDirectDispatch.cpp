@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestDirectDispatch
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testVariableExistence) {
+  checkDoocsProperty<D_int>("//FIRST/A", true, false);
+  checkDoocsProperty<D_int>("//SECOND/A", true, false);
+  checkDoocsProperty<D_double>("//THIRD/A", true, false);
+  checkDoocsProperty<D_intarray>("//FIRST/ARRAY", true, false);
+  checkDoocsProperty<D_intarray>("//SECOND/ARRAY", true, false);
+}
+
+/**********************************************************************************************************************/
+
+/// All properties sharing an accessor are updated by a single notification
+BOOST_AUTO_TEST_CASE(testSharedAccessor) {
+  for(int i = 0; i < 3; ++i) {
+    std::vector<int> array(10);
+    for(size_t k = 0; k < array.size(); ++k) {
+      array[k] = 100 * i + int(k);
+    }
+    write("INT", 42 + i);
+    write("INT_ARRAY", array);
+    runMainLoop();
+
+    expect("//FIRST/A", 42 + i);
+    expect("//SECOND/A", 42 + i);
+    expect("//THIRD/A", 42. + i);
+    expect("//FIRST/ARRAY", array);
+    expect("//SECOND/ARRAY", array);
+  }
+}
+
+/**********************************************************************************************************************/
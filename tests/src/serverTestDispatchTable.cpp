@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestDispatchTable
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// Each update must reach exactly the properties of its process variable. Different values are used for each variable,
+/// so an update dispatched to the wrong entry is detected.
+BOOST_AUTO_TEST_CASE(testDispatch) {
+  for(int i = 0; i < 5; ++i) {
+    std::vector<int> array(10);
+    for(size_t k = 0; k < array.size(); ++k) {
+      array[k] = 40 + i + int(k);
+    }
+    // The macro pulse number and the data need the same version number
+    GlobalFixture::referenceTestApplication.versionNumber = VersionNumber();
+    write("MACRO_PULSE_NUMBER", 1000U + unsigned(i));
+    write("INT", 10 + i);
+    write("FLOAT", 20.5F + float(i));
+    write("DOUBLE", 30.25 + i);
+    write("INT_ARRAY", array);
+    runMainLoop();
+
+    expect("//DATA/INT", 10 + i);
+    expect("//DATA/FLOAT", 20.5F + float(i));
+    expect("//DATA/DOUBLE", 30.25 + i);
+    expect("//DATA/INT_ARRAY", array);
+    expect("//COPY/INT", 10 + i);
+  }
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestEventBuilder
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// A complete event is published right away
+BOOST_AUTO_TEST_CASE(testCompleteEvent) {
+  write("INT", 42);
+  write("FLOAT", 4.5F);
+  runMainLoop();
+
+  expect("//EVENT/A", 42);
+  expect("//EVENT/B", 4.5F);
+}
+
+/**********************************************************************************************************************/
+
+/// An incomplete event is held back until the timeout has expired
+BOOST_AUTO_TEST_CASE(testIncompleteEvent) {
+  write("INT", 43);
+  runMainLoop();
+
+  usleep(50000);
+  BOOST_CHECK(hasValue("//EVENT/A", 42));
+
+  expect("//EVENT/A", 43);
+  BOOST_CHECK(hasValue("//EVENT/B", 4.5F));
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestFanOut
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// Each copy must receive the complete data of each update, also after the buffers have been swapped
+BOOST_AUTO_TEST_CASE(testArrayCopies) {
+  for(int i = 0; i < 3; ++i) {
+    std::vector<int> array(10);
+    for(size_t k = 0; k < array.size(); ++k) {
+      array[k] = 100 * i + int(k);
+    }
+    write("INT_ARRAY", array);
+    runMainLoop();
+
+    expect("//FIRST/ARRAY", array);
+    expect("//SECOND/ARRAY", array);
+    expect("//THIRD/ARRAY", array);
+  }
+}
+
+/**********************************************************************************************************************/
+
+/// The property and the StatusHandler of the location both receive the status code
+BOOST_AUTO_TEST_CASE(testSharedStatusSource) {
+  auto errorCode = [] {
+    auto* location = getLocationFromPropertyAddress("//STATUS/CODE");
+    location->lock();
+    int code = location->get_error();
+    location->unlock();
+    return static_cast<eq_errors>(code);
+  };
+
+  // 1 is StatusAccessorBase::Status::FAULT
+  write("INT", 1);
+  runMainLoop();
+  expect("//STATUS/CODE", 1);
+  checkWithTimeout<eq_errors>(errorCode, not_available);
+
+  // 0 is StatusAccessorBase::Status::OK
+  write("INT", 0);
+  runMainLoop();
+  expect("//STATUS/CODE", 0);
+  checkWithTimeout<eq_errors>(errorCode, no_error);
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestLowLatency
+
+#include "UpdaterTestFixture.h"
+
+#include <sched.h>
+
+#include <filesystem>
+#include <thread>
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// The updater thread is pinned to CPU 0, so exactly one thread of this process must only be allowed to run on CPU 0.
+/// This can only be distinguished if the process may use more than one CPU.
+BOOST_AUTO_TEST_CASE(testCpuAffinity) {
+  cpu_set_t processCpus;
+  BOOST_REQUIRE_EQUAL(sched_getaffinity(0, sizeof(processCpus), &processCpus), 0);
+  if(CPU_COUNT(&processCpus) < 2 || !CPU_ISSET(0, &processCpus)) {
+    BOOST_TEST_MESSAGE("Skipping the affinity check, the process cannot use CPU 0 and another CPU.");
+    return;
+  }
+
+  size_t nPinnedThreads = 0;
+  for(const auto& task : std::filesystem::directory_iterator("/proc/self/task")) {
+    cpu_set_t cpus;
+    if(sched_getaffinity(std::stoi(task.path().filename().string()), sizeof(cpus), &cpus) != 0) {
+      continue; // the thread has terminated meanwhile
+    }
+    if(CPU_COUNT(&cpus) == 1 && CPU_ISSET(0, &cpus)) {
+      ++nPinnedThreads;
+    }
+  }
+  BOOST_CHECK_EQUAL(nPinnedThreads, 1);
+}
+
+/**********************************************************************************************************************/
+
+/// The latency is measured from the creation of the version number to the update of the property. Updates whose
+/// version number has been created 20 ms before they are written must show up with at least this latency.
+BOOST_AUTO_TEST_CASE(testLatencyMeasurement) {
+  auto nUpdates = updater().getLatencyStatistics().nUpdates;
+  constexpr auto delay = std::chrono::milliseconds(20);
+
+  for(int i = 0; i < 3; ++i) {
+    write("INT", 30 + i);
+    write("DOUBLE_ARRAY", std::vector<double>(10, 0.25 + i));
+    GlobalFixture::referenceTestApplication.versionNumber = VersionNumber();
+    std::this_thread::sleep_for(delay);
+    runMainLoop();
+    expect("//LATENCY/INT", 30 + i);
+    expect("//LATENCY/DOUBLE_ARRAY", std::vector<double>(10, 0.25 + i));
+  }
+  GlobalFixture::referenceTestApplication.versionNumber = std::nullopt;
+
+  CHECK_WITH_TIMEOUT(updater().getLatencyStatistics().nUpdates >= nUpdates + 6);
+  auto statistics = updater().getLatencyStatistics();
+  BOOST_CHECK_GE(statistics.max.count(), std::chrono::nanoseconds(delay).count());
+  BOOST_CHECK_LE(statistics.max.count(), statistics.total.count());
+}
+
+/**********************************************************************************************************************/
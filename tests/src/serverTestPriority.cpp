@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestPriority
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// While the updater waits for BLOCK, an update for LOW arrives before an update for HIGH. The update for HIGH must be
+/// dispatched first: it arrives while LOW is still held. In the order of arrival, the updater would wait for LOW.
+BOOST_AUTO_TEST_CASE(testDispatchOrder) {
+  auto nHigh = updater().getWaitTimeStatistics(UpdatePriority::high).nUpdates;
+  auto nLow = updater().getWaitTimeStatistics(UpdatePriority::low).nUpdates;
+
+  LocationLock blockLock("//BLOCK/DOUBLE");
+  LocationLock lowLock("//LOW/FLOAT");
+  write("DOUBLE", 1.5);
+  runMainLoop();
+  write("FLOAT", 2.5F);
+  runMainLoop();
+  write("INT", 3);
+  runMainLoop();
+  blockLock.unlock();
+
+  expect("//HIGH/INT", 3);
+  expect("//BLOCK/DOUBLE", 1.5);
+  lowLock.unlock();
+  expect("//LOW/FLOAT", 2.5F);
+
+  // the wait times are recorded for each priority class
+  BOOST_CHECK_EQUAL(updater().getWaitTimeStatistics(UpdatePriority::high).nUpdates, nHigh + 1);
+  BOOST_CHECK_EQUAL(updater().getWaitTimeStatistics(UpdatePriority::low).nUpdates, nLow + 1);
+}
+
+/**********************************************************************************************************************/
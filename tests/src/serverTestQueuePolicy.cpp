@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestQueuePolicy
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// While LATEST is held, updates pile up in the queues. With the policy latest, the backlog is collapsed afterwards:
+/// all but the newest pending update are skipped. Both properties must end up with the newest value.
+BOOST_AUTO_TEST_CASE(testBacklog) {
+  auto nSkipped = updater().getNumberOfSkippedUpdates();
+
+  LocationLock lock("//LATEST/A");
+  for(int i = 0; i < 5; ++i) {
+    write("INT", 100 + i);
+    write("FLOAT", 0.5F + float(i));
+    runMainLoop();
+  }
+  lock.unlock();
+
+  expect("//LATEST/A", 104);
+  expect("//ALL/B", 4.5F);
+  BOOST_CHECK_GT(updater().getNumberOfSkippedUpdates(), nSkipped);
+}
+
+/**********************************************************************************************************************/
+
+/// Without a backlog, nothing is skipped
+BOOST_AUTO_TEST_CASE(testNoBacklog) {
+  auto nSkipped = updater().getNumberOfSkippedUpdates();
+
+  for(int i = 0; i < 3; ++i) {
+    write("INT", 200 + i);
+    runMainLoop();
+    expect("//LATEST/A", 200 + i);
+  }
+  BOOST_CHECK_EQUAL(updater().getNumberOfSkippedUpdates(), nSkipped);
+}
+
+/**********************************************************************************************************************/
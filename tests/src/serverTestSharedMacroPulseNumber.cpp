@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestSharedMacroPulseNumber
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+struct SharedMacroPulseNumberFixture {
+  unsigned int macroPulseNumber = 1000;
+  int value = 0;
+
+  std::vector<int> arrayValue() const {
+    std::vector<int> array(10);
+    for(size_t k = 0; k < array.size(); ++k) {
+      array[k] = value + int(k);
+    }
+    return array;
+  }
+
+  void sendValues() {
+    ++value;
+    write("INT", value);
+    write("DOUBLE", value + 0.5);
+    write("FLOAT", float(value) + 0.25F);
+    write("INT_ARRAY", arrayValue());
+  }
+
+  void sendMacroPulseNumber() {
+    ++macroPulseNumber;
+    write("MACRO_PULSE_NUMBER", macroPulseNumber);
+  }
+
+  void checkReceivedValues(int expected) {
+    expect("//DATA/INT", expected);
+    expect("//DATA/DOUBLE", expected + 0.5);
+    expect("//OTHER/FLOAT", float(expected) + 0.25F);
+  }
+};
+
+/**********************************************************************************************************************/
+
+/// A single update of the macro pulse number must complete the consistent sets of all properties of the location
+BOOST_FIXTURE_TEST_CASE(testSharedMacroPulseNumber, SharedMacroPulseNumberFixture) {
+  // macro pulse number and data in the same update
+  GlobalFixture::referenceTestApplication.versionNumber = VersionNumber();
+  sendMacroPulseNumber();
+  sendValues();
+  runMainLoop();
+  checkReceivedValues(value);
+  expect("//DATA/INT_ARRAY", arrayValue());
+
+  // data first: nothing is published until the matching macro pulse number arrives
+  int published = value;
+  VersionNumber version;
+  GlobalFixture::referenceTestApplication.versionNumber = version;
+  sendValues();
+  runMainLoop();
+  expectUnchanged("//DATA/INT", published);
+  expectUnchanged("//DATA/DOUBLE", published + 0.5);
+  expectUnchanged("//OTHER/FLOAT", float(published) + 0.25F);
+
+  GlobalFixture::referenceTestApplication.versionNumber = version;
+  sendMacroPulseNumber();
+  runMainLoop();
+  checkReceivedValues(value);
+  expect("//DATA/INT_ARRAY", arrayValue());
+}
+
+/**********************************************************************************************************************/
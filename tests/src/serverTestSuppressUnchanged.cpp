@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestSuppressUnchanged
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+static doocs::Timestamp getTimestamp(const std::string& propertyAddress) {
+  auto* location = getLocationFromPropertyAddress(propertyAddress);
+  location->lock();
+  auto timestamp = getDoocsProperty<D_intarray>(propertyAddress)->get_timestamp();
+  location->unlock();
+  return timestamp;
+}
+
+/**********************************************************************************************************************/
+
+/// Write the array and wait until the property without suppression has published it
+static void sendArray(const std::vector<int>& array) {
+  auto lastTimestamp = getTimestamp("//DATA/PLAIN");
+  write("ARRAY", array);
+  runMainLoop();
+  CHECK_WITH_TIMEOUT(getTimestamp("//DATA/PLAIN") != lastTimestamp);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testSuppressUnchanged) {
+  std::vector<int> first{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<int> second{1, 2, 3, 4, 5, 6, 7, 8, 9, 11};
+
+  sendArray(first);
+  expect("//DATA/SUPPRESSED", first);
+  auto published = getTimestamp("//DATA/SUPPRESSED");
+
+  // identical data: the update is skipped, so the time stamp stays
+  sendArray(first);
+  expectUnchanged("//DATA/SUPPRESSED", first);
+  BOOST_CHECK(getTimestamp("//DATA/SUPPRESSED") == published);
+
+  // a single changed element is published
+  sendArray(second);
+  expect("//DATA/SUPPRESSED", second);
+  BOOST_CHECK(getTimestamp("//DATA/SUPPRESSED") != published);
+  published = getTimestamp("//DATA/SUPPRESSED");
+
+  // a changed validity is published, even with identical data
+  GlobalFixture::referenceTestApplication.dataValidity = DataValidity::faulty;
+  sendArray(second);
+  CHECK_WITH_TIMEOUT(getTimestamp("//DATA/SUPPRESSED") != published);
+  GlobalFixture::referenceTestApplication.dataValidity = DataValidity::ok;
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestUpdateThunk
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+/// Each update function must update its own property with the right type. Different values are used for each variable,
+/// so an update function called with the wrong property is detected.
+BOOST_AUTO_TEST_CASE(testUpdateFunctions) {
+  for(int i = 0; i < 3; ++i) {
+    std::vector<int> intArray(10);
+    std::vector<double> doubleArray(10);
+    std::vector<float> floatArray(10);
+    for(size_t k = 0; k < 10; ++k) {
+      intArray[k] = 60 + i + int(k);
+      doubleArray[k] = 70.5 + i + double(k);
+      floatArray[k] = 80.F + float(i) + float(k);
+    }
+    write("INT", -10 - i);
+    write("UINT", unsigned(20 + i));
+    write("SHORT", -30 - i);
+    write("FLOAT", 40.5F + float(i));
+    write("DOUBLE", 50.25 + i);
+    write("INT_ARRAY", intArray);
+    write("DOUBLE_ARRAY", doubleArray);
+    write("FLOAT_ARRAY", floatArray);
+    runMainLoop();
+
+    expect("//DATA/INT", -10 - i);
+    expect("//DATA/UINT", unsigned(20 + i));
+    expect("//DATA/SHORT", -30 - i);
+    expect("//DATA/FLOAT", 40.5F + float(i));
+    expect("//DATA/DOUBLE", 50.25 + i);
+    expect("//DATA/INT_ARRAY", intArray);
+    expect("//DATA/DOUBLE_ARRAY", doubleArray);
+    // we have to get the data as float in order to work with spectra
+    expect("//DATA/SPECTRUM", floatArray);
+  }
+}
+
+/**********************************************************************************************************************/
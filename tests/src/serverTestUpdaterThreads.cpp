@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE serverTestUpdaterThreads
+
+#include "UpdaterTestFixture.h"
+
+using namespace ChimeraTK;
+using namespace UpdaterTest;
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testUpdates) {
+  write("INT", 42);
+  write("FLOAT", 4.25F);
+  runMainLoop();
+
+  expect("//INT/A", 42);
+  expect("//SHARED/A", 42);
+  expect("//FLOAT/B", 4.25F);
+}
+
+/**********************************************************************************************************************/
+
+/// Each location is served by its own thread, so a busy location does not hold back the updates of the others
+BOOST_AUTO_TEST_CASE(testBusyLocation) {
+  LocationLock lock("//INT/A");
+  write("INT", 120);
+  write("FLOAT", 12.5F);
+  runMainLoop();
+
+  expect("//SHARED/A", 120);
+  expect("//FLOAT/B", 12.5F);
+  lock.unlock();
+
+  expect("//INT/A", 120);
+}
+
+/**********************************************************************************************************************/
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE AllocationFreeUpdateTest
+// Only after defining the name include the unit test header.
+#include <boost/test/included/unit_test.hpp>
+
+#include "AllocationCounter.h"
+#include "DoocsImage.h"
+#include "DoocsProcessArray.h"
+#include "DoocsProcessScalar.h"
+#include "DoocsUpdater.h"
+#include "HistoryDecimator.h"
+
+#include <ChimeraTK/ControlSystemAdapter/ControlSystemPVManager.h>
+#include <ChimeraTK/ControlSystemAdapter/DevicePVManager.h>
+#include <ChimeraTK/MappedImage.h>
+
+#include <doocs/EqFctTest.h>
+
+#include <d_fct.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace boost::unit_test_framework;
+using namespace ChimeraTK;
+
+/**********************************************************************************************************************/
+
+// Note: The other property types, the decorators and the ZeroMQ publication are covered by
+// serverTestAllocationFreeUpdate, which runs the complete server.
+
+doocs::EqFctTest myLocation;
+
+static constexpr size_t nWarmUpIterations = 10;
+static constexpr size_t nIterations = 1000;
+
+/**********************************************************************************************************************/
+
+/// Wait until the condition is fulfilled, while holding the location lock. Returns false after a timeout.
+template<typename CONDITION>
+bool waitUntil(CONDITION condition) {
+  for(size_t i = 0; i < 10000; ++i) {
+    myLocation.lock();
+    bool isFulfilled = condition();
+    myLocation.unlock();
+    if(isFulfilled) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return false;
+}
+
+/**********************************************************************************************************************/
+
+/// Updates processed by the update thread started with DoocsUpdater::run(), i.e. through the ReadAnyGroup and the
+/// dispatch of the update loop
+BOOST_AUTO_TEST_CASE(testUpdateThread) {
+  auto pvManagers = createPVManager();
+  auto csManager = pvManagers.first;
+  auto devManager = pvManagers.second;
+
+  DoocsUpdater updater(csManager);
+
+  constexpr unsigned imageWidth = 32;
+  constexpr unsigned imageHeight = 16;
+
+  auto deviceScalar =
+      devManager->createProcessArray<int32_t>(SynchronizationDirection::deviceToControlSystem, "fromDeviceScalar", 1);
+  auto deviceFloat =
+      devManager->createProcessArray<float>(SynchronizationDirection::deviceToControlSystem, "fromDeviceFloat", 1);
+  auto deviceImage = devManager->createProcessArray<uint8_t>(SynchronizationDirection::deviceToControlSystem,
+      "fromDeviceImage", sizeof(ImgHeader) + imageWidth * imageHeight * 2);
+  auto deviceArray =
+      devManager->createProcessArray<int32_t>(SynchronizationDirection::deviceToControlSystem, "fromDeviceArray", 100);
+
+  DoocsProcessScalar<int32_t, D_int> doocsScalar(&myLocation, "FROM_DEVICE_SCALAR",
+      csManager->getProcessArray<int32_t>("fromDeviceScalar"), updater, DataConsistencyGroup::MatchingMode::exact);
+  DoocsProcessScalar<float, D_float> doocsFloat(&myLocation, "FROM_DEVICE_FLOAT",
+      csManager->getProcessArray<float>("fromDeviceFloat"), updater, DataConsistencyGroup::MatchingMode::exact);
+  DoocsImage doocsImage(&myLocation, "FROM_DEVICE_IMAGE", csManager->getProcessArray<uint8_t>("fromDeviceImage"),
+      updater, DataConsistencyGroup::MatchingMode::exact);
+  DoocsProcessArray<D_intarray, int32_t> doocsArray(&myLocation, "FROM_DEVICE_ARRAY",
+      csManager->getProcessArray<int32_t>("fromDeviceArray"), updater, DataConsistencyGroup::MatchingMode::exact);
+
+  OneDRegisterAccessor<uint8_t> imageAccessor(deviceImage);
+
+  // The array is written last. Its update is processed last, since the update thread processes the updates in the
+  // order of arrival.
+  auto step = [&](int32_t value) {
+    deviceScalar->accessData(0) = value;
+    deviceScalar->write();
+    deviceFloat->accessData(0) = float(value) / 2;
+    deviceFloat->write();
+    MappedImage image(imageAccessor, MappedImage::InitData::Yes);
+    image.setShape(imageWidth, imageHeight, ImgFormat::Gray16);
+    image.interpretedView<uint16_t>()(0, 0) = uint16_t(value);
+    deviceImage->write();
+    for(size_t i = 0; i < deviceArray->getNumberOfSamples(); ++i) {
+      deviceArray->accessData(i) = value + int32_t(i);
+    }
+    deviceArray->write();
+    BOOST_REQUIRE(waitUntil([&] { return doocsArray.value(99) == value + 99; }));
+  };
+
+  updater.run();
+
+  // the first updates may allocate, e.g. to size internal buffers
+  for(size_t i = 0; i < nWarmUpIterations; ++i) {
+    step(int32_t(i));
+  }
+
+  auto nTotal = AllocationCounter::countUpdaterIn([&] {
+    for(size_t i = 0; i < nIterations; ++i) {
+      step(int32_t(i));
+    }
+  });
+  BOOST_CHECK_EQUAL(nTotal, 0);
+
+  updater.stop();
+
+  // make sure the updates have actually been processed
+  BOOST_CHECK_EQUAL(doocsScalar.value(), nIterations - 1);
+  BOOST_CHECK_CLOSE(doocsFloat.value(), float(nIterations - 1) / 2, 0.0001);
+  BOOST_CHECK_EQUAL(int(doocsImage.value()[0]), int((nIterations - 1) & 0xFF));
+  BOOST_CHECK_EQUAL(int(doocsImage.value()[1]), int((nIterations - 1) >> 8));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testHistoryDecimator) {
+  using namespace std::chrono_literals;
+  HistoryDecimator decimator(10., HistoryAggregation::mean);
+  HistoryDecimator::Clock::time_point time{};
+
+  // the first interval sizes the internal buffers
+  for(size_t i = 0; i < nWarmUpIterations * 2; ++i) {
+    decimator.add({1., 2., 3., 4.}, false, time);
+    time += 10ms;
+  }
+
+  size_t nWritten = 0;
+  auto nTotal = AllocationCounter::countIn([&] {
+    for(size_t i = 0; i < nIterations; ++i) {
+      if(decimator.add({1., 2., 3., 4.}, false, time)) {
+        ++nWritten;
+      }
+      time += 10ms;
+    }
+  });
+  BOOST_CHECK_EQUAL(nTotal, 0);
+  BOOST_CHECK_EQUAL(nWritten, nIterations / 10);
+}
+
+/**********************************************************************************************************************/
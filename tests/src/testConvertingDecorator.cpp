@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE ConvertingDecoratorTest
+// Only after defining the name include the unit test header.
+#include <boost/test/included/unit_test.hpp>
+
+#include "ConvertingDecorator.h"
+
+#include <ChimeraTK/ControlSystemAdapter/UnidirectionalProcessArray.h>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_CASE(testReadConversion) {
+  auto [sender, receiver] = createSynchronizedProcessArray<int16_t>(4, "adcData");
+  auto converted = getConvertingDecorator<float>(receiver);
+  BOOST_REQUIRE(converted);
+
+  sender->accessChannel(0) = {-32768, -1, 0, 32767};
+  sender->write();
+  converted->read();
+  BOOST_CHECK_EQUAL(converted->accessData(0), -32768.F);
+  BOOST_CHECK_EQUAL(converted->accessData(1), -1.F);
+  BOOST_CHECK_EQUAL(converted->accessData(2), 0.F);
+  BOOST_CHECK_EQUAL(converted->accessData(3), 32767.F);
+  BOOST_CHECK(converted->getVersionNumber() == receiver->getVersionNumber());
+}
+
+BOOST_AUTO_TEST_CASE(testBooleanConversion) {
+  auto [sender, receiver] = createSynchronizedProcessArray<Boolean>(3, "flags");
+  auto converted = getConvertingDecorator<int32_t>(receiver);
+  BOOST_REQUIRE(converted);
+
+  sender->accessChannel(0) = {true, false, true};
+  sender->write();
+  converted->read();
+  BOOST_CHECK_EQUAL(converted->accessData(0), 1);
+  BOOST_CHECK_EQUAL(converted->accessData(1), 0);
+  BOOST_CHECK_EQUAL(converted->accessData(2), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testWriteConversion) {
+  auto [sender, receiver] = createSynchronizedProcessArray<uint32_t>(2, "counters");
+  auto converted = getConvertingDecorator<double>(sender);
+  BOOST_REQUIRE(converted);
+
+  converted->accessData(0) = 42.7;
+  converted->accessData(1) = 4000000000.;
+  converted->write();
+  receiver->read();
+  BOOST_CHECK_EQUAL(receiver->accessData(0), 42U);
+  BOOST_CHECK_EQUAL(receiver->accessData(1), 4000000000U);
+}
+
+BOOST_AUTO_TEST_CASE(testNonNumericNotHandled) {
+  auto [sender, receiver] = createSynchronizedProcessArray<std::string>(1, "message");
+  BOOST_CHECK(!getConvertingDecorator<float>(receiver));
+
+  auto [intSender, intReceiver] = createSynchronizedProcessArray<int32_t>(1, "value");
+  BOOST_CHECK(!getConvertingDecorator<std::string>(intReceiver));
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE DeadbandFilterTest
+// Only after defining the name include the unit test header.
+#include <boost/test/included/unit_test.hpp>
+
+#include "DeadbandFilter.h"
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_CASE(testInactive) {
+  DeadbandFilter filter;
+  BOOST_CHECK(!filter.isActive());
+  BOOST_CHECK(!filter.isInside({1.}, DataValidity::ok));
+  BOOST_CHECK(!filter.isInside({1.}, DataValidity::ok));
+}
+
+BOOST_AUTO_TEST_CASE(testAbsolute) {
+  DeadbandFilter filter(0.5, 0.);
+  BOOST_CHECK(filter.isActive());
+  // the first update is always published
+  BOOST_CHECK(!filter.isInside({10.}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({10.4}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({9.5}, DataValidity::ok));
+  // the reference is the last published value, so slow drifts are published eventually
+  BOOST_CHECK(!filter.isInside({10.6}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({10.2}, DataValidity::ok));
+  BOOST_CHECK(!filter.isInside({10.}, DataValidity::ok));
+}
+
+BOOST_AUTO_TEST_CASE(testRelative) {
+  DeadbandFilter filter(0., 0.01);
+  BOOST_CHECK(!filter.isInside({1000.}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({1009.}, DataValidity::ok));
+  BOOST_CHECK(!filter.isInside({1011.}, DataValidity::ok));
+  // changes from zero are always published with a pure relative deadband
+  BOOST_CHECK(!filter.isInside({0.}, DataValidity::ok));
+  BOOST_CHECK(!filter.isInside({1e-9}, DataValidity::ok));
+}
+
+BOOST_AUTO_TEST_CASE(testCombined) {
+  // the larger of both deadbands applies
+  DeadbandFilter filter(1., 0.1);
+  BOOST_CHECK(!filter.isInside({0.}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({1.}, DataValidity::ok));
+  BOOST_CHECK(!filter.isInside({100.}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({109.}, DataValidity::ok));
+  BOOST_CHECK(!filter.isInside({111.}, DataValidity::ok));
+}
+
+BOOST_AUTO_TEST_CASE(testValidity) {
+  DeadbandFilter filter(1., 0.);
+  BOOST_CHECK(!filter.isInside({5.}, DataValidity::ok));
+  BOOST_CHECK(!filter.isInside({5.}, DataValidity::faulty));
+  BOOST_CHECK(filter.isInside({5.}, DataValidity::faulty));
+  BOOST_CHECK(!filter.isInside({5.}, DataValidity::ok));
+}
+
+BOOST_AUTO_TEST_CASE(testTuple) {
+  DeadbandFilter filter(0.5, 0.);
+  BOOST_CHECK(!filter.isInside({1., 2., 3.}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({1.1, 2.2, 2.7}, DataValidity::ok));
+  // a single component outside the deadband publishes all components
+  BOOST_CHECK(!filter.isInside({1., 2., 4.}, DataValidity::ok));
+  BOOST_CHECK(filter.isInside({1.4, 2., 4.}, DataValidity::ok));
+}
@@ -7,6 +7,8 @@
 #include <boost/test/included/unit_test.hpp>
 // boost unit_test needs to be included before serverBasedTestTools.h
 
+#include "ConvertingDecorator.h"
+#include "DoocsProcessArray.h"
 #include "DoocsProcessScalar.h"
 #include "DoocsPVFactory.h"
 #include "DoocsSpectrum.h"
@@ -274,5 +276,42 @@ BOOST_AUTO_TEST_CASE(testInt64Scalar) {
   BOOST_CHECK(boost::dynamic_pointer_cast<D_longarray>(variable64));
 }
 
+// Type changes of factory-created properties use the ConvertingDecorator, which is wired in
+// DoocsUpdater::getMappedProcessVariable(), the only place where the factory obtains typed accessors.
+BOOST_AUTO_TEST_CASE(testArrayTypeConversion) {
+  std::pair<shared_ptr<ControlSystemPVManager>, shared_ptr<DevicePVManager>> pvManagers = createPVManager();
+  shared_ptr<ControlSystemPVManager> csManager = pvManagers.first;
+  shared_ptr<DevicePVManager> devManager = pvManagers.second;
+
+  auto deviceArray =
+      devManager->createProcessArray<int16_t>(SynchronizationDirection::deviceToControlSystem, "A/fromDeviceAdc", 4);
+
+  DoocsUpdater updater(csManager);
+
+  DoocsPVFactory factory(&myEqFct, updater);
+
+  // int16 ADC data published as float
+  auto description = std::make_shared<AutoPropertyDescription>(
+      "A/fromDeviceAdc", "A", "fromDeviceAdc", AutoPropertyDescription::DataType::Float);
+  auto variable = factory.create(description);
+  auto* doocsArray = dynamic_cast<DoocsProcessArray<D_floatarray, float>*>(variable.get());
+  BOOST_REQUIRE(doocsArray);
+
+  // the property reads through the ConvertingDecorator, not the generic TypeChangingDecorator
+  BOOST_REQUIRE_EQUAL(updater.getElementsToRead().size(), 1);
+  auto accessor = updater.getElementsToRead().front().getHighLevelImplElement();
+  BOOST_CHECK(boost::dynamic_pointer_cast<ConvertingDecorator<float, int16_t>>(accessor));
+
+  std::vector<int16_t> values{-32768, -3, 0, 32767};
+  for(size_t i = 0; i < values.size(); ++i) {
+    deviceArray->accessData(i) = values[i];
+  }
+  deviceArray->write();
+  updater.update();
+  for(size_t i = 0; i < values.size(); ++i) {
+    BOOST_CHECK_EQUAL(doocsArray->value(int(i)), float(values[i]));
+  }
+}
+
 // After you finished all test you have to end the test suite.
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,8 @@
 
 #include <d_fct.h>
 
+#include <chrono>
+
 using namespace boost::unit_test_framework;
 using namespace ChimeraTK;
 
@@ -315,4 +317,55 @@ BOOST_AUTO_TEST_CASE(fromDeviceDoubleTest) {
   BOOST_CHECK_CLOSE(doocsScalar.value(), 12.125, 0.00001);
 }
 
+
+// manually stepped clock for the rate limit, see PropertyBase::setRateLimitClock()
+static std::chrono::steady_clock::time_point fakeNow{};
+
+BOOST_AUTO_TEST_CASE(fromDeviceMaxRateTest) {
+  std::pair<boost::shared_ptr<ControlSystemPVManager>, boost::shared_ptr<DevicePVManager>> pvManagers =
+      createPVManager();
+  boost::shared_ptr<ControlSystemPVManager> csManager = pvManagers.first;
+  boost::shared_ptr<DevicePVManager> devManager = pvManagers.second;
+
+  DoocsUpdater updater;
+
+  ProcessArray<int32_t>::SharedPtr deviceVariable =
+      devManager->createProcessArray<int32_t>(SynchronizationDirection::deviceToControlSystem, "fromDeviceVariable", 1);
+  ProcessArray<int32_t>::SharedPtr controlSystemVariable = csManager->getProcessArray<int32_t>("fromDeviceVariable");
+
+  DoocsProcessScalar<int32_t, D_int> doocsScalar(
+      &myLocation, "FROM_DEVICE_VARIABLE", controlSystemVariable, updater, DataConsistencyGroup::MatchingMode::exact);
+  // 10 Hz, i.e. at most one update per 100 ms
+  doocsScalar.setMaxRate(10.);
+  doocsScalar.setRateLimitClock([] { return fakeNow; });
+  fakeNow += std::chrono::seconds(1);
+
+  // the first update is published immediately
+  deviceVariable->accessData(0) = 1;
+  deviceVariable->write();
+  updater.update();
+  BOOST_CHECK_EQUAL(doocsScalar.value(), 1);
+
+  // the following updates within the interval are conflated
+  deviceVariable->accessData(0) = 2;
+  deviceVariable->write();
+  updater.update();
+  deviceVariable->accessData(0) = 3;
+  deviceVariable->write();
+  updater.update();
+  BOOST_CHECK_EQUAL(doocsScalar.value(), 1);
+  BOOST_CHECK_EQUAL(doocsScalar.getNumberOfConflatedUpdates(), 1);
+
+  // nothing is published before the interval has passed
+  fakeNow += std::chrono::milliseconds(99);
+  doocsScalar.flushConflatedUpdate();
+  BOOST_CHECK_EQUAL(doocsScalar.value(), 1);
+
+  // after the interval, the latest value is published
+  fakeNow += std::chrono::milliseconds(1);
+  doocsScalar.flushConflatedUpdate();
+  BOOST_CHECK_EQUAL(doocsScalar.value(), 3);
+  BOOST_CHECK_EQUAL(doocsScalar.getNumberOfConflatedUpdates(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
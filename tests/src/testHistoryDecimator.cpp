@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_MODULE HistoryDecimatorTest
+// Only after defining the name include the unit test header.
+#include <boost/test/included/unit_test.hpp>
+
+#include "HistoryDecimator.h"
+
+using namespace ChimeraTK;
+using namespace std::chrono_literals;
+
+// 10 Hz, i.e. one history entry per 100 ms
+static const HistoryDecimator::Clock::time_point t0{};
+
+BOOST_AUTO_TEST_CASE(testInactive) {
+  HistoryDecimator decimator;
+  BOOST_CHECK(!decimator.isActive());
+  BOOST_CHECK(!HistoryDecimator(0., HistoryAggregation::mean).isActive());
+  BOOST_CHECK(HistoryDecimator(10., HistoryAggregation::mean).isActive());
+}
+
+BOOST_AUTO_TEST_CASE(testMean) {
+  HistoryDecimator decimator(10., HistoryAggregation::mean);
+  // the first sample is written immediately
+  auto sample = decimator.add({1.}, false, t0);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 1.);
+
+  // the interval starts with the next sample
+  BOOST_CHECK(!decimator.add({2.}, false, t0 + 10ms));
+  BOOST_CHECK(!decimator.add({4.}, false, t0 + 50ms));
+  sample = decimator.add({6.}, false, t0 + 110ms, 42);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 3.);
+  BOOST_CHECK(!sample->isFaulty);
+  BOOST_CHECK(sample->time == t0 + 50ms);
+
+  // the sample finishing the interval starts the next one
+  BOOST_CHECK(!decimator.add({1.}, false, t0 + 120ms));
+  sample = decimator.add({3.}, false, t0 + 210ms);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 3.5);
+}
+
+BOOST_AUTO_TEST_CASE(testBoundary) {
+  HistoryDecimator decimator(10., HistoryAggregation::last);
+  BOOST_REQUIRE(decimator.add({0.}, false, t0));
+  BOOST_CHECK(!decimator.add({1.}, false, t0 + 10ms, 1));
+  BOOST_CHECK(!decimator.add({2.}, false, t0 + 109ms, 2));
+  // a sample exactly at the end of the interval is not part of it
+  auto sample = decimator.add({3.}, false, t0 + 110ms, 3);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 2.);
+  BOOST_CHECK_EQUAL(sample->eventId, 2);
+  BOOST_CHECK(sample->time == t0 + 109ms);
+
+  sample = decimator.add({4.}, false, t0 + 210ms, 4);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 3.);
+  BOOST_CHECK_EQUAL(sample->eventId, 3);
+}
+
+BOOST_AUTO_TEST_CASE(testFlush) {
+  HistoryDecimator decimator(10., HistoryAggregation::max);
+  // nothing to flush before the first sample and after the first sample, which has been returned immediately
+  BOOST_CHECK(!decimator.flush(t0));
+  BOOST_REQUIRE(decimator.add({0.}, false, t0));
+  BOOST_CHECK(!decimator.flush(t0 + 1s));
+
+  BOOST_CHECK(!decimator.add({5.}, false, t0 + 10ms));
+  BOOST_CHECK(!decimator.add({2.}, true, t0 + 20ms));
+  // the interval has not ended yet
+  BOOST_CHECK(!decimator.flush(t0 + 109ms));
+  // the last interval is written without a further sample
+  auto sample = decimator.flush(t0 + 110ms);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 5.);
+  BOOST_CHECK(sample->isFaulty);
+  BOOST_CHECK(!decimator.flush(t0 + 1s));
+
+  // the next sample starts a new interval, it is not written immediately
+  BOOST_CHECK(!decimator.add({1.}, false, t0 + 500ms));
+  sample = decimator.flush(t0 + 600ms);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 1.);
+  BOOST_CHECK(!sample->isFaulty);
+}
+
+BOOST_AUTO_TEST_CASE(testMinMaxLast) {
+  for(auto aggregation : {HistoryAggregation::min, HistoryAggregation::max, HistoryAggregation::last}) {
+    HistoryDecimator decimator(10., aggregation);
+    BOOST_REQUIRE(decimator.add({0.}, false, t0));
+    BOOST_CHECK(!decimator.add({5.}, false, t0 + 10ms));
+    BOOST_CHECK(!decimator.add({-3.}, false, t0 + 20ms));
+    BOOST_CHECK(!decimator.add({2.}, false, t0 + 30ms));
+    auto sample = decimator.add({7.}, false, t0 + 110ms);
+    BOOST_REQUIRE(sample);
+    double expected = aggregation == HistoryAggregation::min ? -3. : (aggregation == HistoryAggregation::max ? 5. : 2.);
+    BOOST_CHECK_EQUAL(sample->values[0], expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testTupleAndFaulty) {
+  HistoryDecimator decimator(10., HistoryAggregation::max);
+  BOOST_REQUIRE(decimator.add({0., 0.}, false, t0));
+  BOOST_CHECK(!decimator.add({1., 7.}, true, t0 + 10ms));
+  BOOST_CHECK(!decimator.add({3., 2.}, false, t0 + 50ms));
+  auto sample = decimator.add({1., 1.}, false, t0 + 110ms);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK_EQUAL(sample->values[0], 3.);
+  BOOST_CHECK_EQUAL(sample->values[1], 7.);
+  // one faulty sample marks the whole entry
+  BOOST_CHECK(sample->isFaulty);
+
+  sample = decimator.add({1., 1.}, false, t0 + 210ms);
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK(!sample->isFaulty);
+}
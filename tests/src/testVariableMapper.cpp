@@ -181,3 +181,171 @@ BOOST_AUTO_TEST_CASE(testCodeIsInconsisten) {
               << e.what() << std::endl;
   }
 }
+
+BOOST_AUTO_TEST_CASE(testUpdaterZeroThreads) {
+  try {
+    testXmlParsing("variableTreeXml/updaterZeroThreads.xml");
+    BOOST_ERROR("testUpdaterZeroThreads did not throw as expected.");
+  }
+  catch(std::exception& e) {
+    std::cout << " -- For manually checking the exception message for "
+                 "number of updater threads < 1:\n      "
+              << e.what() << std::endl;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterThreads) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/updaterThreads.xml");
+  BOOST_CHECK_EQUAL(vm.getUpdaterConfig().nThreads, 4);
+
+  // without updater tag, the defaults must be restored
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK_EQUAL(vm.getUpdaterConfig().nThreads, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterBatch) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/updaterBatch.xml");
+  BOOST_CHECK_EQUAL(vm.getUpdaterConfig().batchSize, 16);
+  BOOST_CHECK(vm.getUpdaterConfig().batchTimeBudget == std::chrono::microseconds(500));
+
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK_EQUAL(vm.getUpdaterConfig().batchSize, 1);
+  BOOST_CHECK(vm.getUpdaterConfig().batchTimeBudget == std::chrono::microseconds(0));
+}
+
+/// Find the description of a property of the last parsed file
+std::shared_ptr<PropertyDescription> findProperty(const std::string& location, const std::string& name) {
+  for(auto& property : VariableMapper::getInstance().getPropertiesInLocation(location)) {
+    if(property->name == name) {
+      return property;
+    }
+  }
+  BOOST_FAIL("Property " + location + "/" + name + " not found");
+  return {};
+}
+
+BOOST_AUTO_TEST_CASE(testPropertyMaxRate) {
+  testXmlParsing("variableTreeXml/propertyMaxRate.xml");
+  BOOST_CHECK_CLOSE(findProperty("GLOBAL", "B")->maxRate, 5., 0.0001);
+  BOOST_CHECK_CLOSE(findProperty("DIRECT", "DOUBLE")->maxRate, 10., 0.0001);
+  BOOST_CHECK_EQUAL(findProperty("DIRECT", "INT")->maxRate, 0.);
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterDirectDispatch) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/updaterDirectDispatch.xml");
+  BOOST_CHECK(vm.getUpdaterConfig().directDispatch);
+
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK(!vm.getUpdaterConfig().directDispatch);
+}
+
+BOOST_AUTO_TEST_CASE(testPropertyLazy) {
+  testXmlParsing("variableTreeXml/propertyLazy.xml");
+  BOOST_CHECK(findProperty("GLOBAL", "B")->lazy);
+  BOOST_CHECK(!findProperty("DIRECT", "DOUBLE")->lazy);
+  BOOST_CHECK(findProperty("DIRECT", "INT")->lazy);
+}
+
+BOOST_AUTO_TEST_CASE(testPropertySuppressUnchanged) {
+  testXmlParsing("variableTreeXml/propertySuppressUnchanged.xml");
+  BOOST_CHECK(findProperty("GLOBAL", "B")->suppressUnchanged);
+  BOOST_CHECK(!findProperty("DIRECT", "DOUBLE")->suppressUnchanged);
+  BOOST_CHECK(findProperty("DIRECT", "INT")->suppressUnchanged);
+}
+
+BOOST_AUTO_TEST_CASE(testPropertyDeadband) {
+  testXmlParsing("variableTreeXml/propertyDeadband.xml");
+  BOOST_CHECK_CLOSE(findProperty("GLOBAL", "B")->deadbandAbsolute, 1., 0.0001);
+  BOOST_CHECK_CLOSE(findProperty("DIRECT", "DOUBLE")->deadbandAbsolute, 0.5, 0.0001);
+  BOOST_CHECK_EQUAL(findProperty("DIRECT", "DOUBLE")->deadbandRelative, 0.);
+  BOOST_CHECK_EQUAL(findProperty("DIRECT", "INT")->deadbandAbsolute, 0.);
+  BOOST_CHECK_CLOSE(findProperty("DIRECT", "INT")->deadbandRelative, 0.1, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(testPropertyHistoryDecimation) {
+  testXmlParsing("variableTreeXml/propertyHistoryDecimation.xml");
+  BOOST_CHECK_EQUAL(findProperty("GLOBAL", "B")->historyMaxRate, 0.);
+  BOOST_CHECK(findProperty("GLOBAL", "B")->historyAggregation == HistoryAggregation::min);
+  BOOST_CHECK_CLOSE(findProperty("DIRECT", "DOUBLE")->historyMaxRate, 2., 0.0001);
+  BOOST_CHECK(findProperty("DIRECT", "DOUBLE")->historyAggregation == HistoryAggregation::max);
+  BOOST_CHECK_EQUAL(findProperty("DIRECT", "INT")->historyMaxRate, 0.);
+  BOOST_CHECK(findProperty("DIRECT", "INT")->historyAggregation == HistoryAggregation::last);
+}
+
+BOOST_AUTO_TEST_CASE(testLocationEventBuilder) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/locationEventBuilder.xml");
+  auto& timeouts = vm.getUpdaterConfig().eventBuilderTimeouts;
+  BOOST_CHECK_EQUAL(timeouts.size(), 2);
+  BOOST_CHECK(timeouts.at("EVENTS") == std::chrono::microseconds(2000));
+  BOOST_CHECK(timeouts.at("DEFAULT_TIMEOUT") == std::chrono::microseconds(10000));
+
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK(vm.getUpdaterConfig().eventBuilderTimeouts.empty());
+}
+
+BOOST_AUTO_TEST_CASE(testPropertyQueue) {
+  testXmlParsing("variableTreeXml/propertyQueue.xml");
+  BOOST_CHECK((findProperty("GLOBAL", "B")->queue == QueueConfig{2, QueuePolicy::all}));
+  BOOST_CHECK((findProperty("DIRECT", "DOUBLE")->queue == QueueConfig{5, QueuePolicy::latest}));
+  BOOST_CHECK((findProperty("DIRECT", "INT")->queue == QueueConfig{0, QueuePolicy::all}));
+}
+
+BOOST_AUTO_TEST_CASE(testPropertyPriority) {
+  testXmlParsing("variableTreeXml/propertyPriority.xml");
+  BOOST_CHECK(findProperty("GLOBAL", "B")->priority == UpdatePriority::low);
+  BOOST_CHECK(findProperty("DIRECT", "DOUBLE")->priority == UpdatePriority::high);
+  BOOST_CHECK(findProperty("DIRECT", "INT")->priority == UpdatePriority::normal);
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterFairness) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/updaterFairness.xml");
+  BOOST_CHECK_EQUAL(vm.getUpdaterConfig().fairnessLimit, 3);
+
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK_EQUAL(vm.getUpdaterConfig().fairnessLimit, 0);
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterDeferBusyLocations) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/updaterDeferBusyLocations.xml");
+  BOOST_CHECK(vm.getUpdaterConfig().deferBusyLocations);
+
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK(!vm.getUpdaterConfig().deferBusyLocations);
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterLowLatency) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/updaterLowLatency.xml");
+  auto& config = vm.getUpdaterConfig();
+  BOOST_CHECK(config.cpuAffinity == std::vector<int>({0, 2}));
+  BOOST_CHECK_EQUAL(config.realtimePriority, 10);
+  BOOST_CHECK(config.lockMemory);
+  BOOST_CHECK(config.spinTime == std::chrono::microseconds(50));
+  BOOST_CHECK(config.measureLatency);
+
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK(vm.getUpdaterConfig().cpuAffinity.empty());
+  BOOST_CHECK_EQUAL(vm.getUpdaterConfig().realtimePriority, 0);
+  BOOST_CHECK(!vm.getUpdaterConfig().measureLatency);
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterAsyncPropagation) {
+  VariableMapper& vm = VariableMapper::getInstance();
+  testXmlParsing("variableTreeXml/updaterAsyncPropagation.xml");
+  BOOST_CHECK(vm.getUpdaterConfig().asyncPropagation);
+
+  testXmlParsing("variableTreeXml/locationTurnOffOn.xml");
+  BOOST_CHECK(!vm.getUpdaterConfig().asyncPropagation);
+}
+
+BOOST_AUTO_TEST_CASE(testUpdaterCpuAffinityOutOfRange) {
+  // CPU numbers are passed to CPU_SET(), which does not check the range
+  BOOST_CHECK_THROW(testXmlParsing("variableTreeXml/updaterCpuAffinityNegative.xml"), std::invalid_argument);
+  BOOST_CHECK_THROW(testXmlParsing("variableTreeXml/updaterCpuAffinityTooLarge.xml"), std::invalid_argument);
+}